@@ -81,21 +81,40 @@ private:
 	};
 
 	/**
-	 * Fill the temporary sample buffer used in readBuffer.
+	 * Fill a sample buffer used in readBuffer.
 	 *
+	 * @param dst        Buffer to fill, usually the temporary sample buffer.
 	 * @param maxSamples Maximum samples to read.
 	 * @return actual count of samples read.
 	 */
-	int fillBuffer(int maxSamples);
+	int fillBuffer(byte *dst, int maxSamples);
 };
 
 template<int bytesPerSample, bool isUnsigned, bool isLE>
 int RawStream<bytesPerSample, isUnsigned, isLE>::readBuffer(int16 *buffer, const int numSamples) {
 	int samplesLeft = numSamples;
 
+	// Samples that are already in the native format are read straight into
+	// the caller's buffer, without going through the temporary buffer.
+#ifdef SCUMM_LITTLE_ENDIAN
+	const bool isNative = (bytesPerSample == 2 && !isUnsigned && isLE);
+#else
+	const bool isNative = (bytesPerSample == 2 && !isUnsigned && !isLE);
+#endif
+
 	while (samplesLeft > 0) {
+		if (isNative) {
+			int len = fillBuffer((byte *)buffer, samplesLeft);
+			if (!len)
+				break;
+
+			samplesLeft -= len;
+			buffer += len;
+			continue;
+		}
+
 		// Try to read up to "samplesLeft" samples.
-		int len = fillBuffer(samplesLeft);
+		int len = fillBuffer(_buffer, samplesLeft);
 
 		// In case we were not able to read any samples
 		// we will stop reading here.
@@ -123,9 +142,8 @@ int RawStream<bytesPerSample, isUnsigned, isLE>::readBuffer(int16 *buffer, const
 }
 
 template<int bytesPerSample, bool isUnsigned, bool isLE>
-int RawStream<bytesPerSample, isUnsigned, isLE>::fillBuffer(int maxSamples) {
+int RawStream<bytesPerSample, isUnsigned, isLE>::fillBuffer(byte *dst, int maxSamples) {
 	int bufferedSamples = 0;
-	byte *dst = _buffer;
 
 	// We can only read up to "kSampleBufferLength" samples
 	// so we take this into consideration, when trying to
@@ -21,6 +21,7 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/config-manager.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -42,7 +43,7 @@ namespace Audio {
  */
 class Channel {
 public:
-	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent);
+	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, RateConverterQuality quality);
 	~Channel();
 
 	/**
@@ -197,10 +198,14 @@ private:
 #pragma mark -
 
 MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
-	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0),
+	  _rateConverterQuality(kRateConverterLinear), _soundTypeSettings(), _stateMutex(), _commandQueueStart(0), _commandQueueCount(0) {
 
 	assert(sampleRate > 0);
 
+	if (ConfMan.get("rate_converter") == "polyphase")
+		_rateConverterQuality = kRateConverterPolyphase;
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = nullptr;
 }
@@ -220,6 +225,18 @@ uint MixerImpl::getOutputRate() const {
 	return _sampleRate;
 }
 
+void MixerImpl::setRateConverterQuality(RateConverterQuality quality) {
+	Common::StackLock lock(_mutex);
+
+	_rateConverterQuality = quality;
+}
+
+RateConverterQuality MixerImpl::getRateConverterQuality() const {
+	Common::StackLock lock(_mutex);
+
+	return _rateConverterQuality;
+}
+
 bool MixerImpl::getOutputStereo() const {
 	return _stereo;
 }
@@ -242,17 +259,138 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 		return;
 	}
 
-	_channels[index] = chan;
-
 	SoundHandle chanHandle;
 	chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
+	if (chanHandle._val == kInvalidHandle) {
+		_handleSeed++;
+		chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
+	}
 
 	chan->setHandle(chanHandle);
 	_handleSeed++;
+
+	// The slot is only published once the channel is fully set up
+	{
+		Common::StackLock lock(_stateMutex);
+		ChannelState &state = _channelStates[index];
+		state.id = chan->getId();
+		state.type = chan->getType();
+		state.volume = chan->getVolume();
+		state.balance = chan->getBalance();
+		state.rate = chan->getRate();
+		state.nativeRate = state.rate;
+		state.handle = chanHandle._val;
+	}
+
+	_channels[index] = chan;
 	if (handle)
 		*handle = chanHandle;
 }
 
+void MixerImpl::removeChannel(int index) {
+	{
+		Common::StackLock lock(_stateMutex);
+		_channelStates[index].handle = kInvalidHandle;
+	}
+	delete _channels[index];
+	_channels[index] = nullptr;
+}
+
+MixerImpl::ChannelState *MixerImpl::findChannelState(SoundHandle handle) {
+	if (handle._val == kInvalidHandle)
+		return nullptr;
+
+	ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+	if (state.handle != handle._val)
+		return nullptr;
+
+	return &state;
+}
+
+void MixerImpl::queueCommand(ChannelCommand::Type type, SoundHandle handle, int32 value) {
+	ChannelCommand command;
+	command.type = type;
+	command.handle = handle._val;
+	command.value = value;
+
+	{
+		Common::StackLock lock(_stateMutex);
+		ChannelState *state = findChannelState(handle);
+		if (!state)
+			return;
+
+		switch (type) {
+		case ChannelCommand::kCommandVolume:
+			state->volume = value;
+			break;
+		case ChannelCommand::kCommandBalance:
+			state->balance = value;
+			break;
+		case ChannelCommand::kCommandRate:
+			state->rate = value;
+			break;
+		case ChannelCommand::kCommandResetRate:
+			state->rate = state->nativeRate;
+			break;
+		default:
+			break;
+		}
+
+		if (_commandQueueCount < COMMAND_QUEUE_SIZE) {
+			_commandQueue[(_commandQueueStart + _commandQueueCount) % COMMAND_QUEUE_SIZE] = command;
+			_commandQueueCount++;
+			return;
+		}
+	}
+
+	// The queue is full: wait for the mixer and apply the change right away.
+	// applyCommand() checks the handle again, in case the sound terminated.
+	Common::StackLock lock(_mutex);
+	applyQueuedCommands();
+	applyCommand(command);
+}
+
+void MixerImpl::applyCommand(const ChannelCommand &command) {
+	// Commands for sounds that terminated in the meantime are dropped
+	const int index = command.handle % NUM_CHANNELS;
+	if (!_channels[index] || _channels[index]->getHandle()._val != command.handle)
+		return;
+
+	switch (command.type) {
+	case ChannelCommand::kCommandVolume:
+		_channels[index]->setVolume(command.value);
+		break;
+	case ChannelCommand::kCommandBalance:
+		_channels[index]->setBalance(command.value);
+		break;
+	case ChannelCommand::kCommandRate:
+		_channels[index]->setRate(command.value);
+		break;
+	case ChannelCommand::kCommandResetRate:
+		_channels[index]->resetRate();
+		break;
+	default:
+		break;
+	}
+}
+
+void MixerImpl::applyQueuedCommands() {
+	ChannelCommand commands[COMMAND_QUEUE_SIZE];
+	uint count;
+
+	{
+		Common::StackLock lock(_stateMutex);
+		count = _commandQueueCount;
+		for (uint i = 0; i < count; i++)
+			commands[i] = _commandQueue[(_commandQueueStart + i) % COMMAND_QUEUE_SIZE];
+		_commandQueueStart = (_commandQueueStart + count) % COMMAND_QUEUE_SIZE;
+		_commandQueueCount = 0;
+	}
+
+	for (uint i = 0; i < count; i++)
+		applyCommand(commands[i]);
+}
+
 void MixerImpl::playStream(
 			SoundType type,
 			SoundHandle *handle,
@@ -292,7 +430,7 @@ void MixerImpl::playStream(
 #endif
 
 	// Create the channel
-	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
+	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent, _rateConverterQuality);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
 	insertChannel(handle, chan);
@@ -308,6 +446,8 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
+	applyQueuedCommands();
+
 	//  zero the buf
 	memset(buf, 0, len);
 
@@ -325,8 +465,7 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
 			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = nullptr;
+				removeChannel(i);
 			} else if (!_channels[i]->isPaused()) {
 				tmp = _channels[i]->mix(buf, len);
 
@@ -342,8 +481,7 @@ void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != nullptr && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = nullptr;
+			removeChannel(i);
 		}
 	}
 }
@@ -352,8 +490,7 @@ void MixerImpl::stopID(int id) {
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = nullptr;
+			removeChannel(i);
 		}
 	}
 }
@@ -366,8 +503,7 @@ void MixerImpl::stopHandle(SoundHandle handle) {
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return;
 
-	delete _channels[index];
-	_channels[index] = nullptr;
+	removeChannel(index);
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
@@ -386,67 +522,46 @@ bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setVolume(volume);
+	queueCommand(ChannelCommand::kCommandVolume, handle, volume);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Common::StackLock lock(_stateMutex);
+	const ChannelState *state = findChannelState(handle);
+	if (!state)
 		return 0;
 
-	return _channels[index]->getVolume();
+	return state->volume;
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setBalance(balance);
+	queueCommand(ChannelCommand::kCommandBalance, handle, balance);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Common::StackLock lock(_stateMutex);
+	const ChannelState *state = findChannelState(handle);
+	if (!state)
 		return 0;
 
-	return _channels[index]->getBalance();
+	return state->balance;
 }
 
 void MixerImpl::setChannelRate(SoundHandle handle, uint32 rate) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setRate(rate);
+	queueCommand(ChannelCommand::kCommandRate, handle, rate);
 }
 
 uint32 MixerImpl::getChannelRate(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Common::StackLock lock(_stateMutex);
+	const ChannelState *state = findChannelState(handle);
+	if (!state)
 		return 0;
-	
-	return _channels[index]->getRate();
+
+	return state->rate;
 }
 
 void MixerImpl::resetChannelRate(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-	
-	_channels[index]->resetRate();
+	queueCommand(ChannelCommand::kCommandResetRate, handle, 0);
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -504,41 +619,38 @@ void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
+	Common::StackLock lock(_stateMutex);
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getId() == id)
+		if (_channelStates[i].handle != kInvalidHandle && _channelStates[i].id == id)
 			return true;
 	return false;
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
+	Common::StackLock lock(_stateMutex);
+	const ChannelState *state = findChannelState(handle);
+	if (state)
+		return state->id;
 	return 0;
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	Common::StackLock lock(_stateMutex);
+	return findChannelState(handle) != nullptr;
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_stateMutex);
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getType() == type)
+		if (_channelStates[i].handle != kInvalidHandle && _channelStates[i].type == type)
 			return true;
 	return false;
 }
@@ -573,7 +685,7 @@ int MixerImpl::getVolumeForSoundType(SoundType type) const {
 #pragma mark -
 
 Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
-				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent)
+				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, RateConverterQuality quality)
 	: _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
 	  _balance(0), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
 	  _pauseStartTime(0), _pauseTime(0), _converter(nullptr), _volL(0), _volR(0),
@@ -582,7 +694,7 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo);
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo, quality);
 }
 
 Channel::~Channel() {
@@ -25,6 +25,7 @@
 #include "common/scummsys.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
+#include "audio/rate.h"
 
 namespace Audio {
 
@@ -68,6 +69,7 @@ private:
 	const uint _outBufSize;
 	bool _mixerReady;
 	uint32 _handleSeed;
+	RateConverterQuality _rateConverterQuality;
 
 	struct SoundTypeSettings {
 		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
@@ -79,6 +81,57 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	/**
+	 * Published state of a channel slot. It is only accessed with _stateMutex
+	 * held: the mixer updates it whenever a channel is added or removed, the
+	 * channel setters and queries use it instead of the channel itself, so
+	 * they never wait for a mixing pass to finish.
+	 */
+	struct ChannelState {
+		ChannelState() : handle(kInvalidHandle), id(-1), type(kPlainSoundType), volume(0), balance(0), rate(0), nativeRate(0) {}
+
+		uint32 handle;
+		int id;
+		SoundType type;
+		byte volume;
+		int8 balance;
+		uint32 rate;
+		uint32 nativeRate;
+	};
+
+	ChannelState _channelStates[NUM_CHANNELS];
+
+	/**
+	 * Channel parameter change requested by the engine. The changes are
+	 * queued and applied by the mixer at the start of the next mixing pass,
+	 * so that setting them never waits for the current pass to finish.
+	 */
+	struct ChannelCommand {
+		enum Type {
+			kCommandVolume,
+			kCommandBalance,
+			kCommandRate,
+			kCommandResetRate
+		};
+
+		Type type;
+		uint32 handle;
+		int32 value;
+	};
+
+	enum {
+		kInvalidHandle = 0xffffffff,
+		COMMAND_QUEUE_SIZE = 64
+	};
+
+	// Guards the published channel states and the command queue. It is never
+	// held for longer than it takes to look up a slot or to queue or dequeue
+	// a few commands. When both are needed, _mutex is locked first.
+	Common::Mutex _stateMutex;
+	ChannelCommand _commandQueue[COMMAND_QUEUE_SIZE];
+	uint _commandQueueStart;
+	uint _commandQueueCount;
+
 
 public:
 
@@ -138,6 +191,23 @@ public:
 
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
+	void removeChannel(int index);
+
+	/**
+	 * Returns the published state of the channel with the given handle,
+	 * or nullptr when the sound has already terminated. Must be called with
+	 * _stateMutex held.
+	 */
+	ChannelState *findChannelState(SoundHandle handle);
+
+	/**
+	 * Queues a change to the channel with the given handle. The handle is
+	 * checked, the published state updated and the command queued in one
+	 * go, so a slot that gets reused meanwhile never sees the change.
+	 */
+	void queueCommand(ChannelCommand::Type type, SoundHandle handle, int32 value);
+	void applyCommand(const ChannelCommand &command);
+	void applyQueuedCommands();
 
 public:
 	/**
@@ -157,6 +227,14 @@ public:
 	 * their audio system has been completed.
 	 */
 	void setReady(bool ready);
+
+	/**
+	 * Set the resampling algorithm used for sounds started from now on.
+	 * It is initialized from the "rate_converter" configuration key, which
+	 * is either "linear" or "polyphase".
+	 */
+	void setRateConverterQuality(RateConverterQuality quality);
+	RateConverterQuality getRateConverterQuality() const;
 };
 
 /** @} */
@@ -29,7 +29,9 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/rate_polyphase.h"
 #include "audio/mixer.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace Audio {
@@ -95,6 +97,40 @@ public:
 	bool needsDraining() const override { return _bufferSize != 0; }
 };
 
+/**
+ * Applies the channel volumes to a run of input frames and mixes them into
+ * the output buffer. Keeping the loop free of any buffer management lets
+ * the compiler vectorize it.
+ */
+template<bool inStereo, bool outStereo, bool reverseStereo>
+static inline void mixFrames(const st_sample_t *in, st_sample_t *out, int frames, st_volume_t volL, st_volume_t volR) {
+	for (int i = 0; i < frames; i++) {
+		st_sample_t inL, inR;
+		inL = in[0];
+		inR = (inStereo ? in[1] : inL);
+		in += (inStereo ? 2 : 1);
+
+		st_sample_t outL, outR;
+		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+
+		if (outStereo) {
+			// Output left channel
+			clampedAdd(out[reverseStereo    ], outL);
+
+			// Output right channel
+			clampedAdd(out[reverseStereo ^ 1], outR);
+
+			out += 2;
+		} else {
+			// Output mono channel
+			clampedAdd(out[0], (outL + outR) / 2);
+
+			out += 1;
+		}
+	}
+}
+
 template<bool inStereo, bool outStereo, bool reverseStereo>
 int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	st_sample_t *outStart, *outEnd;
@@ -112,30 +148,19 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 				return (outBuffer - outStart) / (outStereo ? 2 : 1);
 		}
 
-		// Mix the data into the output buffer
-		st_sample_t inL, inR;
-		inL = *_bufferPos++;
-		inR = (inStereo ? *_bufferPos++ : inL);
-		_bufferSize -= (inStereo ? 2 : 1);
-
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// Output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// Output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+		// Mix as many frames as both buffers allow in one go
+		const int frames = MIN<int>(_bufferSize / (inStereo ? 2 : 1), (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		if (frames == 0) {
+			// Drop an incomplete stereo frame
+			_bufferSize = 0;
+			continue;
+		}
 
-			outBuffer += 2;
-		} else {
-			// Output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
+		mixFrames<inStereo, outStereo, reverseStereo>(_bufferPos, outBuffer, frames, volL, volR);
 
-			outBuffer += 1;
-		}
+		_bufferPos += frames * (inStereo ? 2 : 1);
+		_bufferSize -= frames * (inStereo ? 2 : 1);
+		outBuffer += frames * (outStereo ? 2 : 1);
 	}
 
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
@@ -297,21 +322,273 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream
 	}
 }
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
+int polyphaseDotProductGeneric(const st_sample_t *samples, const int16 *coefs) {
+	int sum = 0;
+	for (int i = 0; i < POLYPHASE_TAPS; i++)
+		sum += samples[i] * coefs[i];
+	return sum;
+}
+
+PolyphaseDotProductFunc getPolyphaseDotProduct() {
+	// Converters can be created before the backend is set up
+	if (!g_system)
+		return polyphaseDotProductGeneric;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		return polyphaseDotProductNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		return polyphaseDotProductSSE2;
+#endif
+	return polyphaseDotProductGeneric;
+}
+
+/**
+ * Rate converter using a polyphase windowed-sinc FIR filter. It costs a
+ * fixed POLYPHASE_TAPS multiply-adds per output sample and channel, and
+ * does not alias like linear interpolation does.
+ */
+template<bool inStereo, bool outStereo, bool reverseStereo>
+class RateConverter_Polyphase : public RateConverter {
+private:
+	/** Input and output rates */
+	st_rate_t _inRate, _outRate;
+
+	/** Rates the coefficient table was computed for */
+	st_rate_t _tableInRate, _tableOutRate;
+
+	/**
+	 * The filter coefficients, one row of POLYPHASE_TAPS for each phase,
+	 * plus one row for the position of the next input sample.
+	 */
+	int16 *_coefs;
+
+	/** The intermediate input cache */
+	st_sample_t _buffer[512];
+
+	/** Current position inside the buffer */
+	const st_sample_t *_bufferPos;
+
+	/** Size of data currently loaded into the buffer */
+	int _bufferSize;
+
+	/** Fractional position of the output stream in input stream unit */
+	frac_t _outPosFrac;
+
+	/**
+	 * The last input samples of each channel. Every sample is stored twice,
+	 * so that the last POLYPHASE_TAPS samples are always contiguous.
+	 */
+	st_sample_t _historyL[POLYPHASE_TAPS * 2], _historyR[POLYPHASE_TAPS * 2];
+
+	/** Position of the oldest sample in the history */
+	int _historyPos;
+
+	/** Number of silent samples to feed once the input has ended */
+	int _tailSize;
+
+	/** The inner product implementation for this CPU */
+	PolyphaseDotProductFunc _dotProduct;
+
+	void updateCoefficients();
+	void pushSample(st_sample_t inL, st_sample_t inR);
+
+public:
+	RateConverter_Polyphase(st_rate_t inputRate, st_rate_t outputRate);
+	virtual ~RateConverter_Polyphase() { delete[] _coefs; }
+
+	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
+
+	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; }
+	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; }
+
+	st_rate_t getInputRate() const override { return _inRate; }
+	st_rate_t getOutputRate() const override { return _outRate; }
+
+	bool needsDraining() const override { return _bufferSize != 0 || _tailSize != 0; }
+};
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+RateConverter_Polyphase<inStereo, outStereo, reverseStereo>::RateConverter_Polyphase(st_rate_t inputRate, st_rate_t outputRate) :
+	_inRate(inputRate),
+	_outRate(outputRate),
+	_tableInRate(0),
+	_tableOutRate(0),
+	_bufferPos(nullptr),
+	_bufferSize(0),
+	_outPosFrac(FRAC_ONE_LOW),
+	_historyPos(0),
+	_tailSize(0),
+	_dotProduct(getPolyphaseDotProduct()) {
+	_coefs = new int16[(POLYPHASE_PHASES + 1) * POLYPHASE_TAPS];
+	memset(_historyL, 0, sizeof(_historyL));
+	memset(_historyR, 0, sizeof(_historyR));
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void RateConverter_Polyphase<inStereo, outStereo, reverseStereo>::updateCoefficients() {
+	// The cutoff frequency, relative to the input Nyquist frequency, leaves
+	// some room for the transition band of the filter. It only depends on
+	// the rates when downsampling, so the table is kept as long as possible.
+	const double ratio = MIN<double>(1.0, (double)_outRate / _inRate);
+	const bool unchanged = _tableInRate && ratio == MIN<double>(1.0, (double)_tableOutRate / _tableInRate);
+
+	_tableInRate = _inRate;
+	_tableOutRate = _outRate;
+	if (unchanged)
+		return;
+
+	const double cutoff = 0.95 * ratio;
+	const int halfTaps = POLYPHASE_TAPS / 2;
+	for (int phase = 0; phase <= POLYPHASE_PHASES; phase++) {
+		int16 *row = _coefs + phase * POLYPHASE_TAPS;
+		double values[POLYPHASE_TAPS];
+		double sum = 0.0;
+
+		for (int tap = 0; tap < POLYPHASE_TAPS; tap++) {
+			// Distance from the output position to the input sample, in
+			// input samples. Tap halfTaps - 1 is the sample just before it.
+			const double x = (tap - (halfTaps - 1)) - (double)phase / POLYPHASE_PHASES;
+			const double sinc = (x == 0.0) ? 1.0 : sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+			const double window = (fabs(x) >= halfTaps) ? 0.0 :
+				0.42 + 0.5 * cos(M_PI * x / halfTaps) + 0.08 * cos(2.0 * M_PI * x / halfTaps);
+			values[tap] = sinc * window;
+			sum += values[tap];
+		}
+
+		// Normalize the gain of every phase to exactly one
+		int total = 0;
+		int peak = 0;
+		for (int tap = 0; tap < POLYPHASE_TAPS; tap++) {
+			row[tap] = (int16)floor(values[tap] / sum * (1 << POLYPHASE_COEF_BITS) + 0.5);
+			total += row[tap];
+			if (ABS(row[tap]) > ABS(row[peak]))
+				peak = tap;
+		}
+		row[peak] += (1 << POLYPHASE_COEF_BITS) - total;
+	}
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void RateConverter_Polyphase<inStereo, outStereo, reverseStereo>::pushSample(st_sample_t inL, st_sample_t inR) {
+	_historyL[_historyPos] = _historyL[_historyPos + POLYPHASE_TAPS] = inL;
+	if (inStereo)
+		_historyR[_historyPos] = _historyR[_historyPos + POLYPHASE_TAPS] = inR;
+	_historyPos = (_historyPos + 1) % POLYPHASE_TAPS;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+int RateConverter_Polyphase<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	assert(input.isStereo() == inStereo);
+
+	if (_inRate != _tableInRate || _outRate != _tableOutRate)
+		updateCoefficients();
+
+	// How much to increment _outPosFrac by
+	frac_t outPos_inc = (_inRate << FRAC_BITS_LOW) / _outRate;
+
+	st_sample_t *outStart, *outEnd;
+	outStart = outBuffer;
+	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+
+	while (outBuffer < outEnd) {
+		// Read enough input samples so that _outPosFrac < 0
+		while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
+			// Check if we have to refill the buffer
+			if (_bufferSize == 0) {
+				_bufferPos = _buffer;
+				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+				if (_bufferSize <= 0) {
+					_bufferSize = 0;
+
+					// Flush the samples still inside the filter once the
+					// stream has ended
+					if (_tailSize == 0 || !input.endOfStream())
+						return (outBuffer - outStart) / (outStereo ? 2 : 1);
+
+					_tailSize--;
+					pushSample(0, 0);
+					_outPosFrac -= FRAC_ONE_LOW;
+					continue;
+				}
+			}
+
+			_bufferSize -= (inStereo ? 2 : 1);
+			st_sample_t inL = *_bufferPos++;
+			st_sample_t inR = (inStereo ? *_bufferPos++ : inL);
+			pushSample(inL, inR);
+			_tailSize = POLYPHASE_TAPS / 2;
+
+			_outPosFrac -= FRAC_ONE_LOW;
+		}
+
+		const st_sample_t *historyL = _historyL + _historyPos;
+		const st_sample_t *historyR = _historyR + _historyPos;
+
+		// Loop as long as the _outPos trails behind, and as long as there is
+		// still space in the output buffer.
+		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && outBuffer < outEnd) {
+			const int phase = (_outPosFrac + (1 << (FRAC_BITS_LOW - POLYPHASE_PHASE_BITS - 1))) >> (FRAC_BITS_LOW - POLYPHASE_PHASE_BITS);
+			const int16 *coefs = _coefs + phase * POLYPHASE_TAPS;
+			const int round = 1 << (POLYPHASE_COEF_BITS - 1);
+
+			int inL, inR;
+			inL = CLIP<int>((_dotProduct(historyL, coefs) + round) >> POLYPHASE_COEF_BITS, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+			inR = (inStereo ?
+					CLIP<int>((_dotProduct(historyR, coefs) + round) >> POLYPHASE_COEF_BITS, ST_SAMPLE_MIN, ST_SAMPLE_MAX) :
+					inL);
+
+			st_sample_t outL, outR;
+			outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+			outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+
+			if (outStereo) {
+				// Output left channel
+				clampedAdd(outBuffer[reverseStereo    ], outL);
+
+				// Output right channel
+				clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+
+				outBuffer += 2;
+			} else {
+				// Output mono channel
+				clampedAdd(outBuffer[0], (outL + outR) / 2);
+
+				outBuffer += 1;
+			}
+
+			// Increment output position
+			_outPosFrac += outPos_inc;
+		}
+	}
+	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+}
+
+template<template<bool, bool, bool> class Converter>
+static RateConverter *makeRateConverterImpl(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
 	if (inStereo) {
 		if (outStereo) {
 			if (reverseStereo)
-				return new RateConverter_Impl<true, true, true>(inRate, outRate);
+				return new Converter<true, true, true>(inRate, outRate);
 			else
-				return new RateConverter_Impl<true, true, false>(inRate, outRate);
+				return new Converter<true, true, false>(inRate, outRate);
 		} else
-			return new RateConverter_Impl<true, false, false>(inRate, outRate);
+			return new Converter<true, false, false>(inRate, outRate);
 	} else {
 		if (outStereo) {
-			return new RateConverter_Impl<false, true, false>(inRate, outRate);
+			return new Converter<false, true, false>(inRate, outRate);
 		} else
-			return new RateConverter_Impl<false, false, false>(inRate, outRate);
+			return new Converter<false, false, false>(inRate, outRate);
 	}
 }
 
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterQuality quality) {
+	if (quality == kRateConverterPolyphase)
+		return makeRateConverterImpl<RateConverter_Polyphase>(inRate, outRate, inStereo, outStereo, reverseStereo);
+	else
+		return makeRateConverterImpl<RateConverter_Impl>(inRate, outRate, inStereo, outStereo, reverseStereo);
+}
+
 } // End of namespace Audio
@@ -104,7 +104,25 @@ public:
 	virtual bool needsDraining() const = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo);
+/**
+ * Resampling algorithm used by a RateConverter.
+ */
+enum RateConverterQuality {
+	/**
+	 * Linear interpolation between neighbouring input samples. It is
+	 * cheap, but lets high frequencies alias, most audibly when
+	 * downsampling.
+	 */
+	kRateConverterLinear,
+	/**
+	 * 16-tap Blackman-windowed sinc filter with 256 phases and 14 bit
+	 * coefficients. It costs 16 multiply-adds per output sample and channel,
+	 * and attenuates aliasing far more than linear interpolation.
+	 */
+	kRateConverterPolyphase
+};
+
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterQuality quality = kRateConverterLinear);
 
 /** @} */
 } // End of namespace Audio
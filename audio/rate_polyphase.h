@@ -0,0 +1,60 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AUDIO_RATE_POLYPHASE_H
+#define AUDIO_RATE_POLYPHASE_H
+
+#include "audio/rate.h"
+
+namespace Audio {
+
+/**
+ * Polyphase windowed-sinc filter parameters. Each output sample is the
+ * inner product of the last POLYPHASE_TAPS input samples with one row of
+ * the coefficient table, picked by the fractional position of the output
+ * sample between the two middle input samples.
+ */
+enum {
+	POLYPHASE_TAPS = 16,
+	POLYPHASE_PHASE_BITS = 8,
+	POLYPHASE_PHASES = (1 << POLYPHASE_PHASE_BITS),
+	POLYPHASE_COEF_BITS = 14
+};
+
+/**
+ * Returns the inner product of POLYPHASE_TAPS samples with POLYPHASE_TAPS
+ * coefficients.
+ */
+typedef int (*PolyphaseDotProductFunc)(const st_sample_t *samples, const int16 *coefs);
+
+int polyphaseDotProductGeneric(const st_sample_t *samples, const int16 *coefs);
+#ifdef SCUMMVM_NEON
+int polyphaseDotProductNEON(const st_sample_t *samples, const int16 *coefs);
+#endif
+#ifdef SCUMMVM_SSE2
+int polyphaseDotProductSSE2(const st_sample_t *samples, const int16 *coefs);
+#endif
+
+/** Returns the fastest inner product the CPU supports. */
+PolyphaseDotProductFunc getPolyphaseDotProduct();
+
+} // End of namespace Audio
+
+#endif
@@ -379,6 +379,13 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
     Bit8u reset = 0;
     slot->eg_out = slot->eg_rout + (slot->reg_tl << 2)
                  + (slot->eg_ksl >> kslshift[slot->reg_ksl]) + *slot->trem;
+    // A released slot whose envelope has fully decayed stays there until it
+    // is keyed on again, so the rate calculation can be skipped.
+    if (!slot->key && slot->eg_gen == envelope_gen_num_release && slot->eg_rout == 0x1ff)
+    {
+        slot->pg_reset = 0;
+        return;
+    }
     if (slot->key && slot->eg_gen == envelope_gen_num_release)
     {
         reset = 1;
@@ -529,22 +536,31 @@ static void OPL3_EnvelopeKeyOff(opl3_slot *slot, Bit8u type)
 // Phase Generator
 //
 
+// The phase increment only changes with the channel frequency or the
+// multiplier, so it is kept precomputed for slots without vibrato.
+static void OPL3_PhaseUpdateInc(opl3_slot *slot)
+{
+    Bit32u basefreq = (slot->channel->f_num << slot->channel->block) >> 1;
+    slot->pg_inc = (basefreq * mt[slot->reg_mult]) >> 1;
+}
+
 static void OPL3_PhaseGenerate(opl3_slot *slot)
 {
     opl3_chip *chip;
     Bit16u f_num;
     Bit32u basefreq;
+    Bit32u pg_inc;
     Bit8u rm_xor, n_bit;
     Bit32u noise;
     Bit16u phase;
 
     chip = slot->chip;
-    f_num = slot->channel->f_num;
     if (slot->reg_vib)
     {
         Bit8s range;
         Bit8u vibpos;
 
+        f_num = slot->channel->f_num;
         range = (f_num >> 7) & 7;
         vibpos = slot->chip->vibpos;
 
@@ -563,14 +579,19 @@ static void OPL3_PhaseGenerate(opl3_slot *slot)
             range = -range;
         }
         f_num += range;
+        basefreq = (f_num << slot->channel->block) >> 1;
+        pg_inc = (basefreq * mt[slot->reg_mult]) >> 1;
+    }
+    else
+    {
+        pg_inc = slot->pg_inc;
     }
-    basefreq = (f_num << slot->channel->block) >> 1;
     phase = (Bit16u)(slot->pg_phase >> 9);
     if (slot->pg_reset)
     {
         slot->pg_phase = 0;
     }
-    slot->pg_phase += (basefreq * mt[slot->reg_mult]) >> 1;
+    slot->pg_phase += pg_inc;
     // Rhythm mode
     noise = chip->noise;
     slot->pg_phase_out = phase;
@@ -637,6 +658,7 @@ static void OPL3_SlotWrite20(opl3_slot *slot, Bit8u data)
     slot->reg_type = (data >> 5) & 0x01;
     slot->reg_ksr = (data >> 4) & 0x01;
     slot->reg_mult = data & 0x0f;
+    OPL3_PhaseUpdateInc(slot);
 }
 
 static void OPL3_SlotWrite40(opl3_slot *slot, Bit8u data)
@@ -798,12 +820,16 @@ static void OPL3_ChannelWriteA0(opl3_channel *channel, Bit8u data)
                  | ((channel->f_num >> (0x09 - channel->chip->nts)) & 0x01);
     OPL3_EnvelopeUpdateKSL(channel->slots[0]);
     OPL3_EnvelopeUpdateKSL(channel->slots[1]);
+    OPL3_PhaseUpdateInc(channel->slots[0]);
+    OPL3_PhaseUpdateInc(channel->slots[1]);
     if (channel->chip->newm && channel->chtype == ch_4op)
     {
         channel->pair->f_num = channel->f_num;
         channel->pair->ksv = channel->ksv;
         OPL3_EnvelopeUpdateKSL(channel->pair->slots[0]);
         OPL3_EnvelopeUpdateKSL(channel->pair->slots[1]);
+        OPL3_PhaseUpdateInc(channel->pair->slots[0]);
+        OPL3_PhaseUpdateInc(channel->pair->slots[1]);
     }
 }
 
@@ -819,6 +845,8 @@ static void OPL3_ChannelWriteB0(opl3_channel *channel, Bit8u data)
                  | ((channel->f_num >> (0x09 - channel->chip->nts)) & 0x01);
     OPL3_EnvelopeUpdateKSL(channel->slots[0]);
     OPL3_EnvelopeUpdateKSL(channel->slots[1]);
+    OPL3_PhaseUpdateInc(channel->slots[0]);
+    OPL3_PhaseUpdateInc(channel->slots[1]);
     if (channel->chip->newm && channel->chtype == ch_4op)
     {
         channel->pair->f_num = channel->f_num;
@@ -826,6 +854,8 @@ static void OPL3_ChannelWriteB0(opl3_channel *channel, Bit8u data)
         channel->pair->ksv = channel->ksv;
         OPL3_EnvelopeUpdateKSL(channel->pair->slots[0]);
         OPL3_EnvelopeUpdateKSL(channel->pair->slots[1]);
+        OPL3_PhaseUpdateInc(channel->pair->slots[0]);
+        OPL3_PhaseUpdateInc(channel->pair->slots[1]);
     }
 }
 
@@ -1069,11 +1099,18 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
 
     buf[1] = OPL3_ClipSample(chip->mixbuff[1]);
 
-    for (ii = 0; ii < 15; ii++)
+    // Envelope and phase of a slot only depend on its own registers and the
+    // chip wide timers, so they are updated for all slots first. Operator
+    // output still has to follow the slot order because of modulation.
+    for (ii = 0; ii < 36; ii++)
     {
-        OPL3_SlotCalcFB(&chip->slot[ii]);
         OPL3_EnvelopeCalc(&chip->slot[ii]);
         OPL3_PhaseGenerate(&chip->slot[ii]);
+    }
+
+    for (ii = 0; ii < 15; ii++)
+    {
+        OPL3_SlotCalcFB(&chip->slot[ii]);
         OPL3_SlotGenerate(&chip->slot[ii]);
     }
 
@@ -1091,8 +1128,6 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
     for (ii = 15; ii < 18; ii++)
     {
         OPL3_SlotCalcFB(&chip->slot[ii]);
-        OPL3_EnvelopeCalc(&chip->slot[ii]);
-        OPL3_PhaseGenerate(&chip->slot[ii]);
         OPL3_SlotGenerate(&chip->slot[ii]);
     }
 
@@ -1101,8 +1136,6 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
     for (ii = 18; ii < 33; ii++)
     {
         OPL3_SlotCalcFB(&chip->slot[ii]);
-        OPL3_EnvelopeCalc(&chip->slot[ii]);
-        OPL3_PhaseGenerate(&chip->slot[ii]);
         OPL3_SlotGenerate(&chip->slot[ii]);
     }
 
@@ -1120,8 +1153,6 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
     for (ii = 33; ii < 36; ii++)
     {
         OPL3_SlotCalcFB(&chip->slot[ii]);
-        OPL3_EnvelopeCalc(&chip->slot[ii]);
-        OPL3_PhaseGenerate(&chip->slot[ii]);
         OPL3_SlotGenerate(&chip->slot[ii]);
     }
 
@@ -1388,17 +1419,83 @@ void OPL3_WriteRegBuffered(opl3_chip *chip, Bit16u reg, Bit8u v)
     chip->writebuf_last = (chip->writebuf_last + 1) % OPL_WRITEBUF_SIZE;
 }
 
-void OPL3_GenerateStream(opl3_chip *chip, Bit16s *sndptr, Bit32u numsamples)
+void OPL3_GenerateBlock(opl3_chip *chip, Bit16s *sndptr, Bit32u numsamples)
 {
     Bit32u i;
 
-    for(i = 0; i < numsamples; i++)
+    for (i = 0; i < numsamples; i++)
     {
-        OPL3_GenerateResampled(chip, sndptr);
+        OPL3_Generate(chip, sndptr);
         sndptr += 2;
     }
 }
 
+void OPL3_GenerateStream(opl3_chip *chip, Bit16s *sndptr, Bit32u numsamples)
+{
+    Bit16s block[2 * OPL_BLOCK_SIZE];
+    Bit32u i, j;
+    Bit32u count, needed;
+    Bit32s samplecnt;
+
+    while (numsamples)
+    {
+        // Find out how many output samples the next block of chip samples
+        // covers, then render the block in one go and resample from it.
+        count = 0;
+        needed = 0;
+        samplecnt = chip->samplecnt;
+        while (count < numsamples)
+        {
+            Bit32u steps = 0;
+            while (samplecnt >= chip->rateratio)
+            {
+                samplecnt -= chip->rateratio;
+                steps++;
+            }
+            if (needed + steps > OPL_BLOCK_SIZE)
+            {
+                break;
+            }
+            needed += steps;
+            samplecnt += 1 << RSM_FRAC;
+            count++;
+        }
+
+        if (count == 0)
+        {
+            // At very low output rates a single output sample needs more
+            // chip samples than a block holds
+            OPL3_GenerateResampled(chip, sndptr);
+            sndptr += 2;
+            numsamples--;
+            continue;
+        }
+
+        OPL3_GenerateBlock(chip, block, needed);
+
+        j = 0;
+        for (i = 0; i < count; i++)
+        {
+            while (chip->samplecnt >= chip->rateratio)
+            {
+                chip->oldsamples[0] = chip->samples[0];
+                chip->oldsamples[1] = chip->samples[1];
+                chip->samples[0] = block[j++];
+                chip->samples[1] = block[j++];
+                chip->samplecnt -= chip->rateratio;
+            }
+            sndptr[0] = (Bit16s)((chip->oldsamples[0] * (chip->rateratio - chip->samplecnt)
+                                + chip->samples[0] * chip->samplecnt) / chip->rateratio);
+            sndptr[1] = (Bit16s)((chip->oldsamples[1] * (chip->rateratio - chip->samplecnt)
+                                + chip->samples[1] * chip->samplecnt) / chip->rateratio);
+            chip->samplecnt += 1 << RSM_FRAC;
+            sndptr += 2;
+        }
+
+        numsamples -= count;
+    }
+}
+
 OPL::OPL(Config::OplType type) : _type(type), _rate(0) {
 }
 
@@ -36,6 +36,7 @@
 
 #define OPL_WRITEBUF_SIZE   1024
 #define OPL_WRITEBUF_DELAY  2
+#define OPL_BLOCK_SIZE      256
 
 namespace OPL {
 namespace NUKED {
@@ -83,6 +84,7 @@ struct _opl3_slot {
     Bit8u key;
     Bit32u pg_reset;
     Bit32u pg_phase;
+    Bit32u pg_inc;
     Bit16u pg_phase_out;
     Bit8u slot_num;
 };
@@ -152,6 +154,7 @@ void OPL3_GenerateResampled(opl3_chip *chip, Bit16s *buf);
 void OPL3_Reset(opl3_chip *chip, Bit32u samplerate);
 void OPL3_WriteReg(opl3_chip *chip, Bit16u reg, Bit8u v);
 void OPL3_WriteRegBuffered(opl3_chip *chip, Bit16u reg, Bit8u v);
+void OPL3_GenerateBlock(opl3_chip *chip, Bit16s *sndptr, Bit32u numsamples);
 void OPL3_GenerateStream(opl3_chip *chip, Bit16s *sndptr, Bit32u numsamples);
 
 class OPL : public ::OPL::EmulatedOPL {
@@ -266,6 +266,12 @@ AbstractFSNode *POSIXFilesystemNode::getParent() const {
 }
 
 Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
+	// Large read-only files are mapped into memory, so that seeking around
+	// in them does not need any system call
+	Common::SeekableReadStream *stream = PosixMmapStream::makeFromPath(getPath());
+	if (stream)
+		return stream;
+
 	return PosixIoStream::makeFromPath(getPath(), false);
 }
 
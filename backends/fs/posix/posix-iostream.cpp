@@ -24,6 +24,14 @@
 #include "backends/fs/posix/posix-iostream.h"
 
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#include <sys/mman.h>
+#include <sys/statvfs.h>
+#define HAS_POSIX_MMAP
+#endif
 
 PosixIoStream *PosixIoStream::makeFromPath(const Common::String &path, bool writeMode) {
 #if defined(HAS_FOPEN64)
@@ -58,3 +66,63 @@ int64 PosixIoStream::size() const {
 
 	return st.st_size;
 }
+
+/*
+ * Smaller files are read through stdio: mapping them costs more than it
+ * saves. The upper limit keeps the address space usage reasonable on
+ * 32-bit systems.
+ */
+enum {
+	kMmapMinSize = 64 * 1024,
+	kMmapMaxSize = (sizeof(void *) >= 8) ? 1024 * 1024 * 1024 : 64 * 1024 * 1024
+};
+
+#ifdef HAS_POSIX_MMAP
+/*
+ * Whether the file can not be truncated by anyone while it is mapped. The
+ * permissions could still be changed by the owner, but game data is not
+ * rewritten while it is being played, unlike saves and configuration files.
+ */
+static bool isReadOnlyFile(int fd, const struct stat &st) {
+	if (!(st.st_mode & (S_IWUSR | S_IWGRP | S_IWOTH)))
+		return true;
+
+	struct statvfs fs;
+	return fstatvfs(fd, &fs) == 0 && (fs.f_flag & ST_RDONLY);
+}
+#endif
+
+PosixMmapStream *PosixMmapStream::makeFromPath(const Common::String &path) {
+#ifdef HAS_POSIX_MMAP
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size < kMmapMinSize || st.st_size > kMmapMaxSize ||
+	    !isReadOnlyFile(fd, st)) {
+		close(fd);
+		return nullptr;
+	}
+
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid after the file descriptor is closed
+	close(fd);
+	if (data == MAP_FAILED)
+		return nullptr;
+
+	return new PosixMmapStream(data, st.st_size);
+#else
+	return nullptr;
+#endif
+}
+
+PosixMmapStream::PosixMmapStream(void *data, uint32 size) :
+		Common::MemoryReadStream((const byte *)data, size), _data(data), _mappedSize(size) {
+}
+
+PosixMmapStream::~PosixMmapStream() {
+#ifdef HAS_POSIX_MMAP
+	munmap(_data, _mappedSize);
+#endif
+}
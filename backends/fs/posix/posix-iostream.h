@@ -23,6 +23,7 @@
 #define BACKENDS_FS_POSIX_POSIXIOSTREAM_H
 
 #include "backends/fs/stdiostream.h"
+#include "common/memstream.h"
 
 /**
  * A file input / output stream using POSIX interfaces
@@ -35,4 +36,29 @@ public:
 	int64 size() const override;
 };
 
+/**
+ * A read stream for a file mapped into memory. Reading and seeking do not
+ * need any system call, and getData() gives direct access to the contents.
+ *
+ * Touching the mapping past the end of the file raises SIGBUS, so only
+ * files which can not be truncated while they are mapped are mapped: files
+ * on a read-only file system, and files nobody has write permission for.
+ */
+class PosixMmapStream final : public Common::MemoryReadStream {
+public:
+	/**
+	 * Maps the file at the given path, if it is a read-only regular file
+	 * whose size is worth mapping and the system supports it. Returns
+	 * nullptr otherwise.
+	 */
+	static PosixMmapStream *makeFromPath(const Common::String &path);
+	~PosixMmapStream() override;
+
+private:
+	PosixMmapStream(void *data, uint32 size);
+
+	void *_data;
+	uint32 _mappedSize;
+};
+
 #endif
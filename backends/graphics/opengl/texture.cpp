@@ -27,6 +27,7 @@
 #include "graphics/opengl/debug.h"
 
 #include "common/algorithm.h"
+#include "common/debug.h"
 #include "common/endian.h"
 #include "common/rect.h"
 #include "common/textconsole.h"
@@ -226,7 +227,7 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 //
 
 Surface::Surface()
-	: _allDirty(false), _dirtyArea() {
+	: _allDirty(false), _dirtyRegion() {
 }
 
 void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcPtr, uint srcPitch) {
@@ -267,22 +268,37 @@ void Surface::fill(const Common::Rect &r, uint32 color) {
 }
 
 void Surface::addDirtyArea(const Common::Rect &r) {
-	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
-	// parameters is an empty rect. Thus, we check whether the current dirty
-	// area is valid. In case it is not we simply use the parameters as new
-	// dirty area. Otherwise, we simply call extend.
-	if (_dirtyArea.isEmpty()) {
-		_dirtyArea = r;
-	} else {
-		_dirtyArea.extend(r);
+	// The dirty region follows the size of the surface. Pending updates
+	// cannot be carried over a size change, so refresh everything then.
+	if (_dirtyRegion.getWidth() != (int)getWidth() || _dirtyRegion.getHeight() != (int)getHeight()) {
+		if (!_dirtyRegion.isEmpty()) {
+			_allDirty = true;
+		}
+
+		_dirtyRegion.setSize(getWidth(), getHeight(), kDirtyTileSize);
 	}
+
+	_dirtyRegion.addRect(r);
 }
 
 Common::Rect Surface::getDirtyArea() const {
 	if (_allDirty) {
 		return Common::Rect(getWidth(), getHeight());
 	} else {
-		return _dirtyArea;
+		return _dirtyRegion.getBoundingRect();
+	}
+}
+
+void Surface::getDirtyRects(Common::Array<Common::Rect> &rects) {
+	if (_allDirty) {
+		rects.clear();
+		rects.push_back(Common::Rect(getWidth(), getHeight()));
+	} else {
+		_dirtyRegion.getRects(rects, kMaxDirtyRects);
+
+		const Graphics::DirtyRegion::Stats &stats = _dirtyRegion.getStats();
+		debugC(kDebugLevelDirtyRects, "OpenGL: %u rects added, %u/%u tiles dirty, %u rects covering %u pixels updated",
+			stats.addedRects, stats.dirtyTiles, stats.totalTiles, stats.outputRects, stats.outputArea);
 	}
 }
 
@@ -343,42 +359,64 @@ void Texture::updateGLTexture() {
 		return;
 	}
 
-	Common::Rect dirtyArea = getDirtyArea();
+	getDirtyRects(_dirtyRects);
+
+	updateGLTexture(_dirtyRects);
+}
 
-	updateGLTexture(dirtyArea);
+static bool compareRectTop(const Common::Rect &a, const Common::Rect &b) {
+	return a.top < b.top;
 }
 
-void Texture::updateGLTexture(Common::Rect &dirtyArea) {
+void Texture::updateGLTexture(Common::Array<Common::Rect> &dirtyRects) {
 	// In case we use linear filtering we might need to duplicate the last
 	// pixel row/column to avoid glitches with filtering.
 	if (_glTexture.isLinearFilteringEnabled()) {
-		if (dirtyArea.right == _userPixelData.w && _userPixelData.w != _textureData.w) {
-			uint height = dirtyArea.height();
+		for (uint i = 0; i < dirtyRects.size(); ++i) {
+			Common::Rect &dirtyArea = dirtyRects[i];
+
+			if (dirtyArea.right == _userPixelData.w && _userPixelData.w != _textureData.w) {
+				uint height = dirtyArea.height();
+
+				const byte *src = (const byte *)_textureData.getBasePtr(_userPixelData.w - 1, dirtyArea.top);
+				byte *dst = (byte *)_textureData.getBasePtr(_userPixelData.w, dirtyArea.top);
 
-			const byte *src = (const byte *)_textureData.getBasePtr(_userPixelData.w - 1, dirtyArea.top);
-			byte *dst = (byte *)_textureData.getBasePtr(_userPixelData.w, dirtyArea.top);
+				while (height-- > 0) {
+					memcpy(dst, src, _textureData.format.bytesPerPixel);
+					dst += _textureData.pitch;
+					src += _textureData.pitch;
+				}
 
-			while (height-- > 0) {
-				memcpy(dst, src, _textureData.format.bytesPerPixel);
-				dst += _textureData.pitch;
-				src += _textureData.pitch;
+				// Extend the dirty area.
+				++dirtyArea.right;
 			}
 
-			// Extend the dirty area.
-			++dirtyArea.right;
+			if (dirtyArea.bottom == _userPixelData.h && _userPixelData.h != _textureData.h) {
+				const byte *src = (const byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h - 1);
+				byte *dst = (byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h);
+				memcpy(dst, src, dirtyArea.width() * _textureData.format.bytesPerPixel);
+
+				// Extend the dirty area.
+				++dirtyArea.bottom;
+			}
 		}
+	}
+
+	// GLTexture::updateArea always uploads whole lines, so upload every
+	// run of lines touched by the dirty rects once.
+	Common::sort(dirtyRects.begin(), dirtyRects.end(), compareRectTop);
 
-		if (dirtyArea.bottom == _userPixelData.h && _userPixelData.h != _textureData.h) {
-			const byte *src = (const byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h - 1);
-			byte *dst = (byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h);
-			memcpy(dst, src, dirtyArea.width() * _textureData.format.bytesPerPixel);
+	uint i = 0;
+	while (i < dirtyRects.size()) {
+		const int16 top = dirtyRects[i].top;
+		int16 bottom = dirtyRects[i].bottom;
 
-			// Extend the dirty area.
-			++dirtyArea.bottom;
+		for (++i; i < dirtyRects.size() && dirtyRects[i].top <= bottom; ++i) {
+			bottom = MAX(bottom, dirtyRects[i].bottom);
 		}
-	}
 
-	_glTexture.updateArea(dirtyArea, _textureData);
+		_glTexture.updateArea(Common::Rect(0, top, _textureData.w, bottom), _textureData);
+	}
 
 	// We should have handled everything, thus not dirty anymore.
 	clearDirty();
@@ -463,15 +501,19 @@ void FakeTexture::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	getDirtyRects(_dirtyRects);
 
-	byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+	for (uint i = 0; i < _dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyArea = _dirtyRects[i];
 
-	applyPaletteAndMask(dst, src, outSurf->pitch, _rgbData.pitch, _rgbData.w, dirtyArea, outSurf->format, _rgbData.format);
+		byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+
+		applyPaletteAndMask(dst, src, outSurf->pitch, _rgbData.pitch, _rgbData.w, dirtyArea, outSurf->format, _rgbData.format);
+	}
 
 	// Do generic handling of updating the texture.
-	Texture::updateGLTexture();
+	Texture::updateGLTexture(_dirtyRects);
 }
 
 void FakeTexture::applyPaletteAndMask(byte *dst, const byte *src, uint dstPitch, uint srcPitch, uint srcWidth, const Common::Rect &dirtyArea, const Graphics::PixelFormat &dstFormat, const Graphics::PixelFormat &srcFormat) const {
@@ -520,29 +562,33 @@ void TextureRGB555::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	getDirtyRects(_dirtyRects);
 
-	uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
+	for (uint i = 0; i < _dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyArea = _dirtyRects[i];
 
-	const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
+		uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint16 color = *src++;
+		const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
 
-			*dst++ =   ((color & 0x7C00) << 1)                             // R
-			         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
-			         | (color & 0x001F);                                   // B
-		}
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint16 color = *src++;
+
+				*dst++ =   ((color & 0x7C00) << 1)                             // R
+				         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
+				         | (color & 0x001F);                                   // B
+			}
 
-		src = (const uint16 *)((const byte *)src + srcAdd);
-		dst = (uint16 *)((byte *)dst + dstAdd);
+			src = (const uint16 *)((const byte *)src + srcAdd);
+			dst = (uint16 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
-	Texture::updateGLTexture();
+	Texture::updateGLTexture(_dirtyRects);
 }
 
 TextureRGBA8888Swap::TextureRGBA8888Swap()
@@ -562,27 +608,31 @@ void TextureRGBA8888Swap::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	getDirtyRects(_dirtyRects);
 
-	uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
+	for (uint i = 0; i < _dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyArea = _dirtyRects[i];
 
-	const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
+		uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint32 color = *src++;
+		const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
 
-			*dst++ = SWAP_BYTES_32(color);
-		}
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint32 color = *src++;
 
-		src = (const uint32 *)((const byte *)src + srcAdd);
-		dst = (uint32 *)((byte *)dst + dstAdd);
+				*dst++ = SWAP_BYTES_32(color);
+			}
+
+			src = (const uint32 *)((const byte *)src + srcAdd);
+			dst = (uint32 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
-	Texture::updateGLTexture();
+	Texture::updateGLTexture(_dirtyRects);
 }
 
 #ifdef USE_SCALERS
@@ -629,46 +679,59 @@ void ScaledTexture::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	Common::Rect dirtyArea = getDirtyArea();
+	getDirtyRects(_dirtyRects);
 
 	// Extend the dirty region for scalers
 	// that "smear" the screen, e.g. 2xSAI
-	dirtyArea.grow(_extraPixels);
-	dirtyArea.clip(Common::Rect(0, 0, _rgbData.w, _rgbData.h));
-
-	const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	uint srcPitch = _rgbData.pitch;
-	byte *dst;
-	uint dstPitch;
+	for (uint i = 0; i < _dirtyRects.size(); ++i) {
+		_dirtyRects[i].grow(_extraPixels);
+		_dirtyRects[i].clip(Common::Rect(0, 0, _rgbData.w, _rgbData.h));
+	}
 
+	// Convert every rect before scaling any of them, since the scaler
+	// also reads the pixels around the rect it scales.
 	if (_convData) {
-		dst = (byte *)_convData->getBasePtr(dirtyArea.left + _extraPixels, dirtyArea.top + _extraPixels);
-		dstPitch = _convData->pitch;
+		for (uint i = 0; i < _dirtyRects.size(); ++i) {
+			const Common::Rect &dirtyArea = _dirtyRects[i];
+			const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+			byte *dst = (byte *)_convData->getBasePtr(dirtyArea.left + _extraPixels, dirtyArea.top + _extraPixels);
 
-		applyPaletteAndMask(dst, src, dstPitch, srcPitch, _rgbData.w, dirtyArea, _convData->format, _rgbData.format);
-
-		src = dst;
-		srcPitch = dstPitch;
+			applyPaletteAndMask(dst, src, _convData->pitch, _rgbData.pitch, _rgbData.w, dirtyArea, _convData->format, _rgbData.format);
+		}
 	}
 
-	dst = (byte *)outSurf->getBasePtr(dirtyArea.left * _scaleFactor, dirtyArea.top * _scaleFactor);
-	dstPitch = outSurf->pitch;
+	_scaledRects.clear();
 
-	if (_scaler && (uint)dirtyArea.height() >= _extraPixels) {
-		_scaler->scale(src, srcPitch, dst, dstPitch, dirtyArea.width(), dirtyArea.height(), dirtyArea.left, dirtyArea.top);
-	} else {
-		Graphics::scaleBlit(dst, src, dstPitch, srcPitch,
-		                    dirtyArea.width() * _scaleFactor, dirtyArea.height() * _scaleFactor,
-		                    dirtyArea.width(), dirtyArea.height(), outSurf->format);
-	}
+	for (uint i = 0; i < _dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyArea = _dirtyRects[i];
+		const byte *src;
+		uint srcPitch;
+
+		if (_convData) {
+			src = (const byte *)_convData->getBasePtr(dirtyArea.left + _extraPixels, dirtyArea.top + _extraPixels);
+			srcPitch = _convData->pitch;
+		} else {
+			src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+			srcPitch = _rgbData.pitch;
+		}
+
+		byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left * _scaleFactor, dirtyArea.top * _scaleFactor);
+		uint dstPitch = outSurf->pitch;
 
-	dirtyArea.left   *= _scaleFactor;
-	dirtyArea.right  *= _scaleFactor;
-	dirtyArea.top    *= _scaleFactor;
-	dirtyArea.bottom *= _scaleFactor;
+		if (_scaler && (uint)dirtyArea.height() >= _extraPixels) {
+			_scaler->scale(src, srcPitch, dst, dstPitch, dirtyArea.width(), dirtyArea.height(), dirtyArea.left, dirtyArea.top);
+		} else {
+			Graphics::scaleBlit(dst, src, dstPitch, srcPitch,
+			                    dirtyArea.width() * _scaleFactor, dirtyArea.height() * _scaleFactor,
+			                    dirtyArea.width(), dirtyArea.height(), outSurf->format);
+		}
+
+		_scaledRects.push_back(Common::Rect(dirtyArea.left * _scaleFactor, dirtyArea.top * _scaleFactor,
+		                                    dirtyArea.right * _scaleFactor, dirtyArea.bottom * _scaleFactor));
+	}
 
 	// Do generic handling of updating the texture.
-	Texture::updateGLTexture(dirtyArea);
+	Texture::updateGLTexture(_scaledRects);
 }
 
 void ScaledTexture::setScaler(uint scalerIndex, int scaleFactor) {
@@ -25,9 +25,11 @@
 #include "graphics/opengl/system_headers.h"
 #include "graphics/opengl/context.h"
 
+#include "graphics/dirtyregion.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 class Scaler;
@@ -224,7 +226,7 @@ public:
 	void fill(const Common::Rect &r, uint32 color);
 
 	void flagDirty() { _allDirty = true; }
-	virtual bool isDirty() const { return _allDirty || !_dirtyArea.isEmpty(); }
+	virtual bool isDirty() const { return _allDirty || !_dirtyRegion.isEmpty(); }
 
 	virtual uint getWidth() const = 0;
 	virtual uint getHeight() const = 0;
@@ -264,13 +266,24 @@ public:
 	 */
 	virtual const GLTexture &getGLTexture() const = 0;
 protected:
-	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); }
+	void clearDirty() { _allDirty = false; _dirtyRegion.clear(); }
 
 	void addDirtyArea(const Common::Rect &r);
 	Common::Rect getDirtyArea() const;
+
+	/**
+	 * Obtain the dirty parts of the surface as a short list of rects.
+	 * Unlike getDirtyArea, this skips clean areas between separate updates.
+	 */
+	void getDirtyRects(Common::Array<Common::Rect> &rects);
 private:
+	enum {
+		kDirtyTileSize = 16,
+		kMaxDirtyRects = 32
+	};
+
 	bool _allDirty;
-	Common::Rect _dirtyArea;
+	Graphics::DirtyRegion _dirtyRegion;
 };
 
 /**
@@ -314,7 +327,10 @@ public:
 protected:
 	const Graphics::PixelFormat _format;
 
-	void updateGLTexture(Common::Rect &dirtyArea);
+	/** Scratch list for the dirty rects of the current update. */
+	Common::Array<Common::Rect> _dirtyRects;
+
+	void updateGLTexture(Common::Array<Common::Rect> &dirtyRects);
 
 private:
 	GLTexture _glTexture;
@@ -388,6 +404,7 @@ public:
 
 	void setScaler(uint scalerIndex, int scaleFactor) override;
 protected:
+	Common::Array<Common::Rect> _scaledRects;
 	Graphics::Surface *_convData;
 	Scaler *_scaler;
 	uint _scalerIndex;
@@ -0,0 +1,152 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/graphics/surfacesdl/scalerpool.h"
+
+#include "common/textconsole.h"
+#include "common/util.h"
+
+ScalerThreadPool::ScalerThreadPool()
+	: _started(false), _done(nullptr), _quit(false), _scaler(nullptr), _srcPtr(nullptr), _dstPtr(nullptr),
+	  _srcPitch(0), _dstPitch(0), _width(0), _height(0), _x(0), _y(0), _numBands(0) {
+}
+
+void ScalerThreadPool::startWorkers() {
+	_started = true;
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	int numWorkers = MIN<int>(SDL_GetCPUCount() - 1, kMaxWorkers);
+	if (numWorkers <= 0)
+		return;
+
+	_done = SDL_CreateSemaphore(0);
+	if (!_done)
+		return;
+
+	// The workers keep a pointer to their entry, so the array must not
+	// be reallocated once the threads are running
+	_workers.resize(numWorkers);
+	for (int i = 0; i < numWorkers; i++) {
+		Worker &worker = _workers[i];
+		worker.pool = this;
+		worker.band = 0;
+		worker.thread = nullptr;
+		worker.start = SDL_CreateSemaphore(0);
+		if (worker.start)
+			worker.thread = SDL_CreateThread(workerMain, "ScummVM scaler", &worker);
+
+		if (!worker.thread) {
+			warning("Could not start scaler thread: %s", SDL_GetError());
+			if (worker.start)
+				SDL_DestroySemaphore(worker.start);
+			_workers.resize(i);
+			break;
+		}
+	}
+#endif
+}
+
+ScalerThreadPool::~ScalerThreadPool() {
+	_quit = true;
+	for (uint i = 0; i < _workers.size(); i++)
+		SDL_SemPost(_workers[i].start);
+
+	for (uint i = 0; i < _workers.size(); i++) {
+		SDL_WaitThread(_workers[i].thread, nullptr);
+		SDL_DestroySemaphore(_workers[i].start);
+	}
+
+	if (_done)
+		SDL_DestroySemaphore(_done);
+}
+
+void ScalerThreadPool::scale(Scaler *scaler, const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+                             uint32 dstPitch, int width, int height, int x, int y) {
+	// Scaling at 1x is a plain copy, and small rects are done before the
+	// workers would even wake up
+	if (scaler->getFactor() <= 1 || width * height < kMinRectArea) {
+		scaler->scale(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+		return;
+	}
+
+	if (!_started)
+		startWorkers();
+
+	int numBands = MIN<int>(_workers.size() + 1, height / kMinBandHeight);
+	if (numBands <= 1) {
+		scaler->scale(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+		return;
+	}
+
+	_scaler = scaler;
+	_srcPtr = srcPtr;
+	_srcPitch = srcPitch;
+	_dstPtr = dstPtr;
+	_dstPitch = dstPitch;
+	_width = width;
+	_height = height;
+	_x = x;
+	_y = y;
+	_numBands = numBands;
+
+	for (int i = 1; i < numBands; i++) {
+		_workers[i - 1].band = i;
+		SDL_SemPost(_workers[i - 1].start);
+	}
+
+	scaleBand(0);
+
+	// Wait for all the other bands before the caller presents the result
+	for (int i = 1; i < numBands; i++)
+		SDL_SemWait(_done);
+}
+
+int SDLCALL ScalerThreadPool::workerMain(void *data) {
+	Worker *worker = (Worker *)data;
+	ScalerThreadPool *pool = worker->pool;
+
+	while (true) {
+		SDL_SemWait(worker->start);
+		if (pool->_quit)
+			break;
+
+		pool->scaleBand(worker->band);
+		SDL_SemPost(pool->_done);
+	}
+
+	return 0;
+}
+
+void ScalerThreadPool::scaleBand(int band) {
+	int top = _height * band / _numBands;
+	int bottom = _height * (band + 1) / _numBands;
+	uint factor = _scaler->getFactor();
+
+	_scaler->scale(_srcPtr + top * _srcPitch, _srcPitch,
+	               _dstPtr + top * factor * _dstPitch, _dstPitch,
+	               _width, bottom - top, _x, _y + top);
+}
+
+#endif
@@ -0,0 +1,84 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+#define BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+
+#include "common/array.h"
+#include "graphics/scalerplugin.h"
+
+#include "backends/platform/sdl/sdl-sys.h"
+
+/**
+ * Scales rects on several threads by splitting them into horizontal bands.
+ *
+ * The calling thread scales the first band itself while the worker threads
+ * handle the others, and scale() only returns once every band is done.
+ * Rects too small to be worth splitting, and rects scaled at 1x, are scaled
+ * directly. The worker threads are only started once a rect needs them.
+ */
+class ScalerThreadPool {
+public:
+	ScalerThreadPool();
+	~ScalerThreadPool();
+
+	/**
+	 * @see Scaler::scale
+	 */
+	void scale(Scaler *scaler, const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+	           uint32 dstPitch, int width, int height, int x, int y);
+
+private:
+	enum {
+		/** Maximum number of worker threads. */
+		kMaxWorkers = 15,
+		/** Minimum height of a band, in source rows. */
+		kMinBandHeight = 16,
+		/** Minimum size of a rect split into bands, in source pixels. */
+		kMinRectArea = 128 * 64
+	};
+
+	struct Worker {
+		ScalerThreadPool *pool;
+		SDL_Thread *thread;
+		SDL_sem *start;
+		int band;
+	};
+
+	static int SDLCALL workerMain(void *data);
+	void startWorkers();
+	void scaleBand(int band);
+
+	bool _started;
+	Common::Array<Worker> _workers;
+	SDL_sem *_done;
+	bool _quit;
+
+	// Parameters of the rect currently being scaled
+	Scaler *_scaler;
+	const uint8 *_srcPtr;
+	uint8 *_dstPtr;
+	uint32 _srcPitch, _dstPitch;
+	int _width, _height, _x, _y;
+	int _numBands;
+};
+
+#endif
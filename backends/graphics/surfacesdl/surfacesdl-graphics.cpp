@@ -25,6 +25,7 @@
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #include "backends/events/sdl/sdl-events.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/mutex.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
@@ -135,7 +136,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_enableFocusRectDebugCode(false), _enableFocusRect(false), _focusRect(),
 #endif
 	_transactionMode(kTransactionNone),
-	_scalerPlugins(ScalerMan.getPlugins()), _scalerPlugin(nullptr), _scaler(nullptr),
+	_scalerPlugins(ScalerMan.getPlugins()), _scalerPlugin(nullptr), _scaler(nullptr), _scaleInBands(false),
 	_needRestoreAfterOverlay(false), _isInOverlayPalette(false), _isDoubleBuf(false), _prevForceRedraw(false), _numPrevDirtyRects(0),
 	_prevCursorNeedsRedraw(false),
 	_mouseKeyColor(0) {
@@ -693,6 +694,7 @@ void SurfaceSdlGraphicsManager::setGraphicsModeIntern() {
 	_scaler->setFactor(_videoMode.scaleFactor);
 	_extraPixels = _scalerPlugin->extraPixels();
 	_useOldSrc = _scalerPlugin->useOldSource();
+	_scaleInBands = _scalerPlugin->canScaleInBands() && !_useOldSrc;
 	if (_useOldSrc) {
 		_scaler->enableSource(true);
 		_scaler->setSource((byte *)_tmpscreen->pixels, _tmpscreen->pitch,
@@ -1020,6 +1022,10 @@ bool SurfaceSdlGraphicsManager::loadGFXMode() {
 	if (_tmpscreen == nullptr)
 		error("allocating _tmpscreen failed");
 
+	// Dirty rects are either in game screen or in overlay coordinates
+	_dirtyRegion.setSize(MAX<int>(_videoMode.screenWidth, _videoMode.overlayWidth),
+	                     MAX<int>(_videoMode.screenHeight, _videoMode.overlayHeight), DIRTY_TILE_SIZE);
+
 	if (_useOldSrc) {
 		// Create surface containing previous frame's data to pass to scaler
 		_scaler->setSource((byte *)_tmpscreen->pixels, _tmpscreen->pitch,
@@ -1309,6 +1315,35 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		_isInOverlayPalette = _overlayVisible;
 	}
 
+	if (!_forceRedraw && !_dirtyRegion.isEmpty()) {
+		_dirtyRegion.getRects(_dirtyRegionRects, NUM_DIRTY_RECT);
+
+		const Graphics::DirtyRegion::Stats &stats = _dirtyRegion.getStats();
+		debugC(kDebugLevelDirtyRects, "SDL: %u rects added, %u/%u tiles dirty, %u rects covering %u pixels updated",
+			stats.addedRects, stats.dirtyTiles, stats.totalTiles, stats.outputRects, stats.outputArea);
+
+		for (uint i = 0; i < _dirtyRegionRects.size(); i++) {
+			Common::Rect &dirty = _dirtyRegionRects[i];
+			dirty.clip(width, height);
+			if (dirty.isEmpty())
+				continue;
+
+			int x = dirty.left, y = dirty.top, w = dirty.width(), h = dirty.height();
+#ifdef USE_ASPECT
+			// Tile alignment may have moved the rect off the lines
+			// makeRectStretchable() picked when it was added
+			if (_videoMode.aspectRatioCorrection && !_overlayInGUI)
+				makeRectStretchable(x, y, w, h, _videoMode.filtering);
+#endif
+
+			SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
+			r->x = x;
+			r->y = y;
+			r->w = w;
+			r->h = h;
+		}
+	}
+
 	// In case of double buferring partially good version may be on another page,
 	// so we need to fully redraw
 	if (_isDoubleBuf && _numDirtyRects)
@@ -1404,8 +1439,12 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				if (_videoMode.aspectRatioCorrection && !_overlayInGUI)
 					dst_y = real2Aspect(dst_y);
 
-				_scaler->scale((byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch, srcPitch,
-						(byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch, dstPitch, dst_w, dst_h, src_x, src_y);
+				const byte *srcPtr = (const byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch;
+				byte *dstPtr = (byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch;
+				if (_scaleInBands)
+					_scalerPool.scale(_scaler, srcPtr, srcPitch, dstPtr, dstPitch, dst_w, dst_h, src_x, src_y);
+				else
+					_scaler->scale(srcPtr, srcPitch, dstPtr, dstPitch, dst_w, dst_h, src_x, src_y);
 
 				r->x = dst_x;
 				r->y = dst_y;
@@ -1524,6 +1563,7 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		_scaler->setFactor(oldScaleFactor);
 
 	_numDirtyRects = 0;
+	_dirtyRegion.clear();
 	_forceRedraw = false;
 	_cursorNeedsRedraw = false;
 #if !SDL_VERSION_ATLEAST(2, 0, 0)
@@ -1729,11 +1769,6 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool in
 	if (_forceRedraw)
 		return;
 
-	if (_numDirtyRects == NUM_DIRTY_RECT) {
-		_forceRedraw = true;
-		return;
-	}
-
 	int height, width;
 
 	if (!inOverlay && !realCoordinates) {
@@ -1784,14 +1819,8 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool in
 		return;
 	}
 
-	if (w > 0 && h > 0) {
-		SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
-
-		r->x = x;
-		r->y = y;
-		r->w = w;
-		r->h = h;
-	}
+	if (w > 0 && h > 0)
+		_dirtyRegion.addRect(Common::Rect(x, y, x + w, y + h));
 }
 
 int16 SurfaceSdlGraphicsManager::getHeight() const {
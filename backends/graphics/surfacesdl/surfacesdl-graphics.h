@@ -24,6 +24,7 @@
 
 #include "backends/graphics/graphics.h"
 #include "backends/graphics/sdl/sdl-graphics.h"
+#include "graphics/dirtyregion.h"
 #include "graphics/pixelformat.h"
 #include "graphics/scaler.h"
 #include "graphics/scalerplugin.h"
@@ -31,6 +32,7 @@
 #include "common/mutex.h"
 
 #include "backends/events/sdl/sdl-events.h"
+#include "backends/graphics/surfacesdl/scalerpool.h"
 
 #include "backends/platform/sdl/sdl-sys.h"
 
@@ -336,6 +338,10 @@ protected:
 	uint _maxExtraPixels;
 	uint _extraPixels;
 
+	// Splits the dirty rects over several threads when the scaler allows it
+	ScalerThreadPool _scalerPool;
+	bool _scaleInBands;
+
 	bool _screenIsLocked;
 	Graphics::Surface _framebuffer;
 
@@ -343,10 +349,16 @@ protected:
 
 	enum {
 		NUM_DIRTY_RECT = 100,
-		MAX_SCALING = 3
+		MAX_SCALING = 3,
+		DIRTY_TILE_SIZE = 8
 	};
 
 	// Dirty rect management
+	// Rects are collected in _dirtyRegion during the frame and turned into
+	// at most NUM_DIRTY_RECT entries of _dirtyRectList before updating.
+	Graphics::DirtyRegion _dirtyRegion;
+	Common::Array<Common::Rect> _dirtyRegionRects;
+
 	// When double-buffering we need to redraw both updates from
 	// current frame and previous frame. For convenience we copy
 	// them here before traversing the list.
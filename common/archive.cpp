@@ -25,6 +25,7 @@
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/memstream.h"
+#include "common/mutex.h"
 #include "common/punycode.h"
 #include "common/debug.h"
 
@@ -176,6 +177,73 @@ char Archive::getPathSeparator() const {
 	return '/';
 }
 
+/**
+ * Contents of the members read by all MemcachingCaseInsensitiveArchive with a
+ * shared contents source, by source and member. Only weak references are
+ * kept: the registry never keeps contents alive by itself.
+ */
+class SharedArchiveContentsRegistry : public Singleton<SharedArchiveContentsRegistry> {
+public:
+	SharedArchiveContentsRegistry() : _insertions(0) {}
+
+	bool find(const String &key, SharedPtr<byte> &contents, uint32 &size);
+	void add(const String &key, const SharedPtr<byte> &contents, uint32 size);
+
+private:
+	struct Ref {
+		WeakPtr<byte> contents;
+		uint32 size;
+	};
+
+	typedef HashMap<String, Ref> RefMap;
+
+	void prune();
+
+	// Archives are opened from several threads, e.g. during detection
+	Mutex _mutex;
+	RefMap _contents;
+	uint _insertions;
+};
+
+bool SharedArchiveContentsRegistry::find(const String &key, SharedPtr<byte> &contents, uint32 &size) {
+	StackLock lock(_mutex);
+
+	RefMap::const_iterator known = _contents.find(key);
+	if (known == _contents.end())
+		return false;
+
+	contents = SharedPtr<byte>(known->_value.contents);
+	size = known->_value.size;
+	return contents;
+}
+
+void SharedArchiveContentsRegistry::add(const String &key, const SharedPtr<byte> &contents, uint32 size) {
+	StackLock lock(_mutex);
+
+	Ref &ref = _contents[key];
+	ref.contents = contents;
+	ref.size = size;
+
+	// Forget about expired contents once in a while
+	if (++_insertions > _contents.size() / 2 + 64)
+		prune();
+}
+
+void SharedArchiveContentsRegistry::prune() {
+	for (RefMap::iterator i = _contents.begin(); i != _contents.end(); ++i) {
+		if (i->_value.contents.expired())
+			_contents.erase(i);
+	}
+	_insertions = 0;
+}
+
+MemcachingCaseInsensitiveArchive::MemcachingCaseInsensitiveArchive(uint32 maxStronglyCachedSize, uint32 maxStronglyCachedTotal)
+	: _strongEntryCount(0), _maxStronglyCachedSize(maxStronglyCachedSize), _maxStronglyCachedTotal(maxStronglyCachedTotal) {
+}
+
+MemcachingCaseInsensitiveArchive::~MemcachingCaseInsensitiveArchive() {
+}
+
 SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMember(const Path &path) const {
 	return createReadStreamForMemberImpl(path, false, Common::AltStreamType::Invalid);
 }
@@ -190,51 +258,108 @@ SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMemberA
 	return createReadStreamForMemberImpl(path, true, altStreamType);
 }
 
+SharedArchiveContents MemcachingCaseInsensitiveArchive::readContents(const CacheKey &cacheKey) const {
+	// Share the contents with other archives reading the same source, as
+	// long as one of them still uses them
+	String sharedKey;
+	if (!_sharedContentsSource.empty()) {
+		sharedKey = String::format("%u:%s:%d:", _sharedContentsSource.size(), _sharedContentsSource.c_str(), (int)cacheKey.altStreamType);
+		sharedKey += cacheKey.path.toString();
+		sharedKey.toLowercase();
+
+		SharedPtr<byte> contents;
+		uint32 size;
+		if (SharedArchiveContentsRegistry::instance().find(sharedKey, contents, size)) {
+			_stats.sharedContents++;
+			return SharedArchiveContents(contents, size);
+		}
+	}
+
+	SharedArchiveContents readResult = (cacheKey.altStreamType != AltStreamType::Invalid) ?
+		readContentsForPathAltStream(cacheKey.path, cacheKey.altStreamType) : readContentsForPath(cacheKey.path);
+	_stats.misses++;
+
+	if (!sharedKey.empty() && !readResult._bypass && !readResult._missingFile && readResult._contentSize)
+		SharedArchiveContentsRegistry::instance().add(sharedKey, readResult._strongRef, readResult._contentSize);
+
+	return readResult;
+}
+
+void MemcachingCaseInsensitiveArchive::keepStrong(const CacheKey &cacheKey, CacheEntry &entry) const {
+	if (entry.isStrong) {
+		// Mark as most recently used
+		_strongEntries.erase(entry.strongPos);
+	} else {
+		_stats.cachedBytes += entry.contents.getSize();
+		_strongEntryCount++;
+		entry.isStrong = true;
+	}
+	_strongEntries.push_back(cacheKey);
+	entry.strongPos = _strongEntries.reverse_begin();
+
+	// Drop the least recently used contents until the budget is met
+	while (_stats.cachedBytes > _maxStronglyCachedTotal && _strongEntryCount > 1) {
+		CacheEntry &oldest = _cache[_strongEntries.front()];
+		dropStrong(oldest);
+		oldest.contents.makeWeak();
+		_stats.evictions++;
+	}
+}
+
+void MemcachingCaseInsensitiveArchive::dropStrong(CacheEntry &entry) const {
+	if (!entry.isStrong)
+		return;
+
+	_strongEntries.erase(entry.strongPos);
+	_stats.cachedBytes -= entry.contents.getSize();
+	_strongEntryCount--;
+	entry.isStrong = false;
+}
+
 SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMemberImpl(const Path &path, bool isAltStream, Common::AltStreamType altStreamType) const {
 	CacheKey cacheKey;
 	cacheKey.path = translatePath(path);
 	cacheKey.altStreamType = isAltStream ? altStreamType : AltStreamType::Invalid;
 
-	bool isNew = false;
+	CacheEntry *entry;
 	if (!_cache.contains(cacheKey)) {
-		SharedArchiveContents readResult = isAltStream ? readContentsForPathAltStream(cacheKey.path, altStreamType) : readContentsForPath(cacheKey.path);
+		SharedArchiveContents readResult = readContents(cacheKey);
 		if (readResult._bypass)
 			return readResult._bypass;
-		_cache[cacheKey] = readResult;
-		isNew = true;
-	}
+		entry = &_cache[cacheKey];
+		entry->contents = readResult;
+	} else {
+		entry = &_cache[cacheKey];
 
-	SharedArchiveContents* entry = &_cache[cacheKey];
+		// Check whether the entry is still valid as WeakPtr might have expired.
+		if (entry->contents.makeStrong()) {
+			_stats.hits++;
+		} else {
+			// If it's expired, recreate the entry.
+			SharedArchiveContents readResult = readContents(cacheKey);
+			if (readResult._bypass)
+				return readResult._bypass;
+			dropStrong(*entry);
+			entry->contents = readResult;
+		}
+	}
 
 	// Errors and missing files. Just return nullptr,
 	// no need to create stream.
-	if (entry->isFileMissing())
-		return nullptr;
-
-	// Check whether the entry is still valid as WeakPtr might have expired.
-	if (!entry->makeStrong()) {
-		// If it's expired, recreate the entry.
-		SharedArchiveContents readResult = isAltStream ? readContentsForPathAltStream(cacheKey.path, altStreamType) : readContentsForPath(cacheKey.path);
-		if (readResult._bypass)
-			return readResult._bypass;
-		_cache[cacheKey] = readResult;
-		entry = &_cache[cacheKey];
-		isNew = true;
-	}
-
 	// It's possible that recreation failed in case of e.g. network
 	// share going offline.
-	if (entry->isFileMissing())
+	if (entry->contents.isFileMissing())
 		return nullptr;
 
 	// Now we have a valid contents reference. Make stream for it.
-	Common::MemoryReadStream *memStream = new Common::MemoryReadStream(entry->getContents(), entry->getSize());
+	Common::MemoryReadStream *memStream = new Common::MemoryReadStream(entry->contents.getContents(), entry->contents.getSize());
 
-	// If the entry was just created and it's too big for strong caching,
-	// mark the copy in cache as weak
-	if (isNew && entry->getSize() > _maxStronglyCachedSize) {
-		entry->makeWeak();
-	}
+	// Keep small contents in memory, within the budget. Bigger contents
+	// only live as long as the streams reading them.
+	if (entry->contents.getSize() > _maxStronglyCachedSize)
+		entry->contents.makeWeak();
+	else if (entry->contents.getSize() > 0)
+		keepStrong(cacheKey, *entry);
 
 	return memStream;
 }
@@ -575,5 +700,6 @@ void SearchManager::clear() {
 }
 
 DECLARE_SINGLETON(SearchManager);
+DECLARE_SINGLETON(SharedArchiveContentsRegistry);
 
 } // namespace Common
@@ -233,6 +233,8 @@ public:
 
 private:
 	SharedArchiveContents(SeekableReadStream *stream) : _strongRef(nullptr), _weakRef(nullptr), _contentSize(0), _missingFile(false), _bypass(stream) {}
+	SharedArchiveContents(const SharedPtr<byte> &contents, uint32 contentSize) :
+		_strongRef(contents), _weakRef(_strongRef), _contentSize(contentSize), _missingFile(false), _bypass(nullptr) {}
 
 	bool isFileMissing() const { return _missingFile; }
 	SharedPtr<byte> getContents() const { return _strongRef; }
@@ -265,10 +267,32 @@ private:
 
 /**
  * An archive that caches the resulting contents.
+ *
+ * Contents up to maxStronglyCachedSize bytes are kept in memory, as long as
+ * all of them together fit in maxStronglyCachedTotal bytes. When they do not,
+ * the least recently used ones are dropped. Bigger contents are only kept for
+ * as long as a stream still reads from them.
+ *
+ * Identical contents read by different archives share the same memory.
  */
 class MemcachingCaseInsensitiveArchive : public Archive {
 public:
-	MemcachingCaseInsensitiveArchive(uint32 maxStronglyCachedSize = 512) : _maxStronglyCachedSize(maxStronglyCachedSize) {}
+	/**
+	 * Statistics about the contents cache of an archive.
+	 */
+	struct CacheStats {
+		CacheStats() : hits(0), misses(0), evictions(0), sharedContents(0), cachedBytes(0) {}
+
+		uint32 hits;           ///< Members served from contents still in memory
+		uint32 misses;         ///< Members that had to be read from the archive
+		uint32 evictions;      ///< Contents dropped to stay within the byte budget
+		uint32 sharedContents; ///< Members sharing the contents read by another archive of the same source
+		uint32 cachedBytes;    ///< Bytes currently kept in memory by the cache
+	};
+
+	MemcachingCaseInsensitiveArchive(uint32 maxStronglyCachedSize = 512, uint32 maxStronglyCachedTotal = 256 * 1024);
+	virtual ~MemcachingCaseInsensitiveArchive();
+
 	SeekableReadStream *createReadStreamForMember(const Path &path) const;
 	SeekableReadStream *createReadStreamForMemberAltStream(const Path &path, Common::AltStreamType altStreamType) const;
 
@@ -279,6 +303,16 @@ public:
 	virtual SharedArchiveContents readContentsForPath(const Path &translatedPath) const = 0;
 	virtual SharedArchiveContents readContentsForPathAltStream(const Path &translatedPath, AltStreamType altStreamType) const;
 
+	const CacheStats &getCacheStats() const { return _stats; }
+
+	/**
+	 * Set the identity of the data read by this archive, e.g. the path of
+	 * the archive file. Archives of the same source share the contents of
+	 * the members they read, as long as one of them still uses them.
+	 * Archives without a source share nothing.
+	 */
+	void setSharedContentsSource(const String &source) { _sharedContentsSource = source; }
+
 private:
 	struct CacheKey {
 		CacheKey();
@@ -295,10 +329,28 @@ private:
 		uint operator()(const CacheKey &x) const;
 	};
 
-	SeekableReadStream *createReadStreamForMemberImpl(const Path &path, bool isAltStream, Common::AltStreamType altStreamType) const;
+	struct CacheEntry {
+		CacheEntry() : isStrong(false) {}
 
-	mutable HashMap<CacheKey, SharedArchiveContents, CacheKey_Hash, CacheKey_EqualTo> _cache;
+		SharedArchiveContents contents;
+		/** Position in _strongEntries, when the contents are kept in memory */
+		List<CacheKey>::iterator strongPos;
+		bool isStrong;
+	};
+
+	SeekableReadStream *createReadStreamForMemberImpl(const Path &path, bool isAltStream, Common::AltStreamType altStreamType) const;
+	SharedArchiveContents readContents(const CacheKey &cacheKey) const;
+	void keepStrong(const CacheKey &cacheKey, CacheEntry &entry) const;
+	void dropStrong(CacheEntry &entry) const;
+
+	mutable HashMap<CacheKey, CacheEntry, CacheKey_Hash, CacheKey_EqualTo> _cache;
+	/** Keys of the contents kept in memory, least recently used first */
+	mutable List<CacheKey> _strongEntries;
+	mutable uint _strongEntryCount;
+	mutable CacheStats _stats;
+	String _sharedContentsSource;
 	uint32 _maxStronglyCachedSize;
+	uint32 _maxStronglyCachedTotal;
 };
 
 /**
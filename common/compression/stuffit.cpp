@@ -119,11 +119,16 @@ static const uint32 s_magicNumbers[] = {
 
 bool StuffItArchive::open(const Common::Path &filename, bool flattenTree) {
 	Common::SeekableReadStream *stream = SearchMan.createReadStreamForMember(filename);
-	return open(stream, flattenTree);
+	if (!open(stream, flattenTree))
+		return false;
+
+	setSharedContentsSource(Common::String::format("stuffit:%d:", flattenTree) + filename.toString());
+	return true;
 }
 
 bool StuffItArchive::open(Common::SeekableReadStream *stream, bool flattenTree) {
 	close();
+	setSharedContentsSource(Common::String());
 
 	_stream = stream;
 	_flattenTree = flattenTree;
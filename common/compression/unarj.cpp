@@ -728,6 +728,11 @@ ArjArchive::~ArjArchive() {
 }
 
 ArjArchive::ArjArchive(const Array<Path> &filenames, bool flattenTree) : _arjFilenames(filenames), _flattenTree(flattenTree) {
+	String source = String::format("arj:%d", flattenTree);
+	for (uint i = 0; i < _arjFilenames.size(); i++)
+		source += String::format(":%u:", _arjFilenames[i].toString().size()) + _arjFilenames[i].toString();
+	setSharedContentsSource(source);
+
 	for (uint i = 0; i < _arjFilenames.size(); i++) {
 		File arjFile;
 
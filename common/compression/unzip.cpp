@@ -95,9 +95,12 @@ typedef Byte Bytef;
 #include "common/compression/deflate.h"
 #include "common/compression/unzip.h"
 #include "common/memstream.h"
+#include "common/mutex.h"
+#include "common/substream.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/ptr.h"
 
 #if defined(STRICTUNZIP) || defined(STRICTZIPUNZIP)
 /* like the STRICT of WIN32, we define a pointer that cannot be converted
@@ -237,6 +240,21 @@ Common::SharedArchiveContents unzOpenCurrentFile(unzFile file
   If there is no error, the return value is UNZ_OK.
 */
 
+Common::SeekableReadStream *unzOpenCurrentFileStream(unzFile file);
+/*
+  Open the current file in the zipfile as a stream reading from the zipfile
+  on demand, if it is big enough to be worth it.
+  The stream keeps the zipfile stream alive, so it stays usable after
+  unzClose. Every read locks the mutex returned by unzGetMutex, which must
+  also guard any other use of the zipfile.
+  Return nullptr if the file should be read with unzOpenCurrentFile instead.
+*/
+
+Common::Mutex &unzGetMutex(unzFile file);
+/*
+  Return the mutex guarding the zipfile stream.
+*/
+
 int unzCloseCurrentFile(unzFile file);
 /*
   Close the file in zip opened with unzOpenCurrentFile
@@ -284,6 +302,16 @@ int unzGetLocalExtrafield(unzFile file, voidp buf, unsigned len);
 #define UNZ_MAXFILENAMEINZIP (256)
 #endif
 
+/* STORED and DEFLATED files bigger than this are streamed from the zipfile
+   instead of being loaded into memory */
+#ifndef UNZ_STREAM_STORED_MIN
+#define UNZ_STREAM_STORED_MIN (64 * 1024)
+#endif
+
+#ifndef UNZ_STREAM_DEFLATED_MIN
+#define UNZ_STREAM_DEFLATED_MIN (1024 * 1024)
+#endif
+
 #define SIZECENTRALDIRITEM (0x2e)
 #define SIZEZIPLOCALHEADER (0x1e)
 
@@ -321,10 +349,21 @@ typedef struct {
 typedef Common::HashMap<Common::Path, cached_file_in_zip, Common::Path::IgnoreCase_Hash,
 	Common::Path::IgnoreCase_EqualTo> ZipHash;
 
+/* the zipfile stream, shared by the zipfile and the files streamed from it.
+   It is deleted once the zipfile is closed and all these streams are gone. */
+struct unz_shared_stream {
+	unz_shared_stream(Common::SeekableReadStream *stream) : _stream(stream) {}
+	~unz_shared_stream() { delete _stream; }
+
+	Common::SeekableReadStream *_stream;
+	Common::Mutex _mutex;
+};
+
 /* unz_s contain internal information about the zipfile
 */
 typedef struct {
 	Common::SeekableReadStream *_stream;				/* io structore of the zipfile */
+	Common::SharedPtr<unz_shared_stream> _shared;	/* owns _stream once opened */
 	unz_global_info gi;				/* public global information */
 	uLong byte_before_the_zipfile;	/* byte before the zipfile, (>0 for sfx)*/
 	uLong num_file;					/* number of the current file in the zipfile*/
@@ -519,6 +558,20 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 		                    (us->offset_central_dir + us->size_central_dir);
 	us->central_pos = central_pos;
 
+	// Walk the central directory from memory. Reading it in one go is much
+	// faster than the many small reads needed to parse it.
+	Common::SeekableReadStream *zipStream = us->_stream;
+	const uLong byteBeforeTheZipfile = us->byte_before_the_zipfile;
+	byte *centralDir = (byte *)malloc(us->size_central_dir);
+	if (centralDir && zipStream->seek(us->offset_central_dir + byteBeforeTheZipfile, SEEK_SET) &&
+	    zipStream->read(centralDir, us->size_central_dir) == us->size_central_dir) {
+		us->_stream = new Common::MemoryReadStream(centralDir, us->size_central_dir, DisposeAfterUse::YES);
+		// Positions in the central directory are relative to its start now
+		us->byte_before_the_zipfile = 0 - us->offset_central_dir;
+	} else {
+		free(centralDir);
+	}
+
 	err = unzGoToFirstFile((unzFile)us);
 
 	while (err == UNZ_OK) {
@@ -585,6 +638,15 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 		// Move to the next file
 		err = unzGoToNextFile((unzFile)us);
 	}
+
+	if (us->_stream != zipStream) {
+		delete us->_stream;
+		us->_stream = zipStream;
+		us->byte_before_the_zipfile = byteBeforeTheZipfile;
+	}
+
+	us->_shared.reset(new unz_shared_stream(us->_stream));
+
 	return (unzFile)us;
 }
 
@@ -600,7 +662,7 @@ int unzClose(unzFile file) {
 		return UNZ_PARAMERROR;
 	s = (unz_s *)file;
 
-	delete s->_stream;
+	// The stream itself goes away with the last file streamed from it
 	delete s;
 	return UNZ_OK;
 }
@@ -984,7 +1046,7 @@ Common::SharedArchiveContents unzOpenCurrentFile (unzFile file
 	uint32 crc32_wait = s->cur_file_info.crc;
 
 	byte *compressedBuffer = new byte[s->cur_file_info.compressed_size];
-	s->_stream->seek(s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar);
+	s->_stream->seek(s->cur_file_info_internal.offset_curfile + s->byte_before_the_zipfile + SIZEZIPLOCALHEADER + iSizeVar);
 	s->_stream->read(compressedBuffer, s->cur_file_info.compressed_size);
 	byte *uncompressedBuffer = nullptr;
 
@@ -1018,6 +1080,132 @@ Common::SharedArchiveContents unzOpenCurrentFile (unzFile file
 	return Common::SharedArchiveContents(uncompressedBuffer, s->cur_file_info.uncompressed_size);
 }
 
+namespace {
+
+/* Reads a part of the zipfile stream, keeping the stream alive */
+class ZipSharedSubReadStream : public Common::SafeMutexedSeekableSubReadStream {
+public:
+	ZipSharedSubReadStream(const Common::SharedPtr<unz_shared_stream> &shared, uint32 begin, uint32 end)
+		: SafeMutexedSeekableSubReadStream(shared->_stream, begin, end, DisposeAfterUse::NO, shared->_mutex), _shared(shared) {
+	}
+
+private:
+	Common::SharedPtr<unz_shared_stream> _shared;
+};
+
+/* Checks the CRC-32 of a streamed file once it has been read up to its end.
+   Only data read in order from the start is checked, so a file read out of
+   order is checked as soon as the reads have covered it all. */
+class ZipCRCReadStream : public Common::SeekableReadStream {
+public:
+	ZipCRCReadStream(Common::SeekableReadStream *parentStream, uint32 crc)
+		: _parentStream(parentStream), _expectedCRC(crc), _checkedSize(0), _crcError(false) {
+#ifndef USE_ZLIB
+		_crc = _crcTable.getInitRemainder();
+#else
+		_crc = crc32(0, Z_NULL, 0);
+#endif
+	}
+
+	~ZipCRCReadStream() override {
+		delete _parentStream;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		const int64 start = _parentStream->pos();
+		const uint32 len = _parentStream->read(dataPtr, dataSize);
+		const int64 end = start + len;
+
+		if (start <= _checkedSize && end > _checkedSize) {
+			const byte *data = (const byte *)dataPtr + (_checkedSize - start);
+			const uint32 count = (uint32)(end - _checkedSize);
+#ifndef USE_ZLIB
+			for (uint32 i = 0; i < count; i++)
+				_crc = _crcTable.processByte(data[i], _crc);
+#else
+			_crc = crc32(_crc, data, count);
+#endif
+			_checkedSize = end;
+
+			if (_checkedSize == _parentStream->size()) {
+#ifndef USE_ZLIB
+				const uint32 crc = _crcTable.finalize(_crc);
+#else
+				const uint32 crc = _crc;
+#endif
+				if (crc != _expectedCRC) {
+					warning("CRC32 mismatch: %08x, %08x", crc, _expectedCRC);
+					_crcError = true;
+				}
+			}
+		}
+
+		return len;
+	}
+
+	bool eos() const override { return _parentStream->eos(); }
+	bool err() const override { return _crcError || _parentStream->err(); }
+	void clearErr() override { _parentStream->clearErr(); }
+	int64 pos() const override { return _parentStream->pos(); }
+	int64 size() const override { return _parentStream->size(); }
+	bool seek(int64 offset, int whence = SEEK_SET) override { return _parentStream->seek(offset, whence); }
+
+private:
+	Common::SeekableReadStream *_parentStream;
+	uint32 _expectedCRC;
+	uint32 _crc;
+	int64 _checkedSize;
+	bool _crcError;
+#ifndef USE_ZLIB
+	Common::CRC32 _crcTable;
+#endif
+};
+
+} // End of anonymous namespace
+
+Common::SeekableReadStream *unzOpenCurrentFileStream(unzFile file) {
+	uInt iSizeVar;
+	unz_s *s;
+	uLong offset_local_extrafield;  /* offset of the local extra field */
+	uInt  size_local_extrafield;    /* size of the local extra field */
+
+	if (file == nullptr)
+		return nullptr;
+	s = (unz_s *)file;
+	if (!s->current_file_ok)
+		return nullptr;
+
+	switch (s->cur_file_info.compression_method) {
+	case 0: // Store
+		if (s->cur_file_info.uncompressed_size <= UNZ_STREAM_STORED_MIN)
+			return nullptr;
+		break;
+	case Z_DEFLATED:
+		if (s->cur_file_info.uncompressed_size <= UNZ_STREAM_DEFLATED_MIN)
+			return nullptr;
+		break;
+	default:
+		return nullptr;
+	}
+
+	if (unzlocal_CheckCurrentFileCoherencyHeader(s, &iSizeVar,
+				&offset_local_extrafield, &size_local_extrafield) != UNZ_OK)
+		return nullptr;
+
+	const uLong begin = s->cur_file_info_internal.offset_curfile + s->byte_before_the_zipfile + SIZEZIPLOCALHEADER + iSizeVar;
+	Common::SeekableReadStream *stream = new ZipSharedSubReadStream(s->_shared,
+			begin, begin + s->cur_file_info.compressed_size);
+
+	if (s->cur_file_info.compression_method == Z_DEFLATED)
+		stream = Common::wrapDeflateReadStream(stream, DisposeAfterUse::YES, s->cur_file_info.uncompressed_size);
+
+	return new ZipCRCReadStream(stream, s->cur_file_info.crc);
+}
+
+Common::Mutex &unzGetMutex(unzFile file) {
+	return ((unz_s *)file)->_shared->_mutex;
+}
+
 
 namespace Common {
 
@@ -1107,8 +1295,16 @@ const ArchiveMemberPtr ZipArchive::getMember(const Path &path) const {
 }
 
 Common::SharedArchiveContents ZipArchive::readContentsForPath(const Common::Path &path) const {
+	// Streamed members read from the zipfile under the same lock
+	Common::StackLock lock(unzGetMutex(_zipFile));
+
 	if (unzLocateFile(_zipFile, path, 2) != UNZ_OK)
 		return Common::SharedArchiveContents();
+
+	SeekableReadStream *stream = unzOpenCurrentFileStream(_zipFile);
+	if (stream)
+		return Common::SharedArchiveContents::bypass(stream);
+
 #ifndef USE_ZLIB
 	return unzOpenCurrentFile(_zipFile, _crc);
 #else
@@ -1116,15 +1312,7 @@ Common::SharedArchiveContents ZipArchive::readContentsForPath(const Common::Path
 #endif
 }
 
-Archive *makeZipArchive(const Path &name, bool flattenTree) {
-	return makeZipArchive(SearchMan.createReadStreamForMember(name), flattenTree);
-}
-
-Archive *makeZipArchive(const FSNode &node, bool flattenTree) {
-	return makeZipArchive(node.createReadStream(), flattenTree);
-}
-
-Archive *makeZipArchive(SeekableReadStream *stream, bool flattenTree) {
+static ZipArchive *openZipArchive(SeekableReadStream *stream, bool flattenTree) {
 	if (!stream)
 		return nullptr;
 	unzFile zipFile = unzOpen(stream, flattenTree);
@@ -1136,4 +1324,23 @@ Archive *makeZipArchive(SeekableReadStream *stream, bool flattenTree) {
 	return new ZipArchive(zipFile, flattenTree);
 }
 
+static Archive *makeSharedZipArchive(SeekableReadStream *stream, bool flattenTree, const String &source) {
+	ZipArchive *archive = openZipArchive(stream, flattenTree);
+	if (archive)
+		archive->setSharedContentsSource(String::format("zip:%d:", flattenTree) + source);
+	return archive;
+}
+
+Archive *makeZipArchive(const Path &name, bool flattenTree) {
+	return makeSharedZipArchive(SearchMan.createReadStreamForMember(name), flattenTree, name.toString());
+}
+
+Archive *makeZipArchive(const FSNode &node, bool flattenTree) {
+	return makeSharedZipArchive(node.createReadStream(), flattenTree, node.getPath().toString());
+}
+
+Archive *makeZipArchive(SeekableReadStream *stream, bool flattenTree) {
+	return openZipArchive(stream, flattenTree);
+}
+
 } // End of namespace Common
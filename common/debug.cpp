@@ -36,6 +36,7 @@ const DebugChannelDef gDebugChannels[] = {
 	{ kDebugGlobalDetection, "detection", "debug messages for advancedDetector" },
 	{ kDebugLevelMainGUI,    "maingui",   "debug messages for GUI" },
 	{ kDebugLevelMacGUI,     "macgui",    "debug messages for MacGUI" },
+	{ kDebugLevelDirtyRects, "dirtyrects", "Screen update statistics of the graphics backends" },
 	DEBUG_CHANNEL_END
 };
 namespace Common {
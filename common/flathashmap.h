@@ -0,0 +1,679 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// The flat hash map in this file follows the layout of the "Swiss tables"
+// found in Abseil: one control byte per slot, probed a group at a time.
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/endian.h"
+#include "common/hashmap.h"
+#include "common/math.h"
+#include "common/textconsole.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FLATHASHMAP_USE_SSE2
+#endif
+
+namespace Common {
+
+/**
+ * @addtogroup common_hashmap
+ * @{
+ */
+
+/**
+ * A group of consecutive control bytes of a FlatHashMap, which are matched
+ * against a value all at once. Control bytes of used slots hold 7 bits of
+ * the hash of their key, free slots have the top bit set.
+ */
+struct FlatHashGroup {
+	enum {
+		kEmpty = 0x80,
+		kDeleted = 0xFE
+	};
+
+#ifdef FLATHASHMAP_USE_SSE2
+	enum { kWidth = 16 };
+	typedef uint32 Mask;
+
+	explicit FlatHashGroup(const byte *ctrl) : _ctrl(_mm_loadu_si128((const __m128i *)ctrl)) {}
+
+	Mask match(byte h2) const { return _mm_movemask_epi8(_mm_cmpeq_epi8(_ctrl, _mm_set1_epi8((char)h2))); }
+	Mask matchEmpty() const { return _mm_movemask_epi8(_mm_cmpeq_epi8(_ctrl, _mm_set1_epi8((char)kEmpty))); }
+	Mask matchFree() const { return _mm_movemask_epi8(_ctrl); }
+
+	/** Return the index of the lowest byte that is set in @p mask. */
+	static uint lowestIndex(Mask mask) { return intLog2(mask & (0 - mask)); }
+
+private:
+	__m128i _ctrl;
+#else
+	// Eight control bytes are matched with plain 64-bit arithmetic.
+	// match() may report a used slot next to an actual match, which is
+	// fine since the keys are compared afterwards anyway.
+	enum { kWidth = 8 };
+	typedef uint64 Mask;
+
+	explicit FlatHashGroup(const byte *ctrl) : _ctrl(READ_LE_UINT64(ctrl)) {}
+
+	Mask match(byte h2) const {
+		const uint64 x = _ctrl ^ (kLsbs * h2);
+		return (x - kLsbs) & ~x & kMsbs;
+	}
+	Mask matchEmpty() const { return _ctrl & ~(_ctrl << 6) & kMsbs; }
+	Mask matchFree() const { return _ctrl & kMsbs; }
+
+	/** Return the index of the lowest byte that is set in @p mask. */
+	static uint lowestIndex(Mask mask) {
+		const uint64 lowest = mask & (0 - mask);
+		const uint32 hi = (uint32)(lowest >> 32);
+		return (hi ? 32 + intLog2(hi) : intLog2((uint32)lowest)) >> 3;
+	}
+
+private:
+	static const uint64 kLsbs = 0x0101010101010101ULL;
+	static const uint64 kMsbs = 0x8080808080808080ULL;
+
+	uint64 _ctrl;
+#endif
+};
+
+/**
+ * FlatHashMap<Key,Val> is a drop-in replacement for HashMap<Key,Val> which
+ * stores its nodes inline in a single array instead of allocating each of
+ * them separately. Next to the nodes it keeps one control byte per slot
+ * with a few bits of the hash, so most lookups touch one group of control
+ * bytes and the node they are looking for.
+ *
+ * The API is the same as the one of HashMap. Unlike with HashMap, nodes
+ * move whenever the map grows, so pointers and references to values are
+ * invalidated by insertions, and so are iterators.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+	struct Node {
+		Val _value;
+		const Key _key;
+		explicit Node(const Key &key) : _value(), _key(key) {}
+		Node(const Node &node) : _value(node._value), _key(node._key) {}
+		Node(Node &&node) : _value(Common::move(node._value)), _key(node._key) {}
+	};
+
+private:
+
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	enum {
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// The map grows once more than 7/8 of its slots have been used.
+		// This guarantees that every probe sequence ends in an empty slot.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 7,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 8
+	};
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	/**
+	 * Control bytes, capacity + FlatHashGroup::kWidth of them. The last
+	 * kWidth bytes mirror the first ones so that a group can be loaded
+	 * at any slot.
+	 */
+	byte *_ctrl;
+	Node *_slots;          ///< Storage for the nodes, only used slots are constructed.
+	size_type _mask;       ///< Capacity of the FlatHashMap minus one; the capacity is a power of two
+	size_type _size;
+	size_type _growthLeft; ///< Number of empty slots which may still be used before growing
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	static bool isFull(byte ctrl) { return ctrl < FlatHashGroup::kEmpty; }
+
+	/**
+	 * Scramble the hash, so that every bit of it affects both the tag and
+	 * the probe start. Otherwise sequential keys, or keys that only differ
+	 * in their high bits like aligned pointers, would cluster.
+	 * This is the MurmurHash3 finalizer.
+	 */
+	static size_type mixHash(size_type hash) {
+		hash ^= hash >> 16;
+		hash *= 0x85EBCA6BU;
+		hash ^= hash >> 13;
+		hash *= 0xC2B2AE35U;
+		return hash ^ (hash >> 16);
+	}
+	static byte h2(size_type hash) { return hash & 0x7F; }
+
+	void setCtrl(size_type idx, byte ctrl) {
+		_ctrl[idx] = ctrl;
+		if (idx < FlatHashGroup::kWidth)
+			_ctrl[_mask + 1 + idx] = ctrl;
+	}
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key) const { return lookup(key, mixHash(_hash(key))); }
+	size_type lookup(const Key &key, size_type hash) const;
+	size_type findFreeSlot(size_type hash) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void rehash(size_type newCapacity);
+
+	template<class T> friend class IteratorImpl;
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(isFull(_hashmap->_ctrl[_idx]));
+			return &_hashmap->_slots[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			do {
+				_idx++;
+			} while (_idx <= _hashmap->_mask && !isFull(_hashmap->_ctrl[_idx]));
+			if (_idx > _hashmap->_mask)
+				_idx = (size_type)-1;
+
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		clear();
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getOrCreateVal(const Key &key);
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getValOrDefault(const Key &key) const;
+	const Val &getValOrDefault(const Key &key, const Val &defaultVal) const;
+	bool tryGetVal(const Key &key, Val &out) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		// Find and return the first used slot
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isFull(_ctrl[ctr]))
+				return iterator(ctr, this);
+		}
+		return end();
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		// Find and return the first used slot
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isFull(_ctrl[ctr]))
+				return const_iterator(ctr, this);
+		}
+		return end();
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		size_type ctr = lookup(key);
+		if (ctr <= _mask)
+			return iterator(ctr, this);
+		return end();
+	}
+
+	const_iterator	find(const Key &key) const {
+		size_type ctr = lookup(key);
+		if (ctr <= _mask)
+			return const_iterator(ctr, this);
+		return end();
+	}
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+/**
+ * Copy constructor, creates a full copy of the given hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) :
+	_defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	clear();
+	freeStorage();
+}
+
+/**
+ * Internal method for allocating empty storage for @p capacity slots.
+ *
+ * @note The previous storage is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	_mask = capacity - 1;
+	_size = 0;
+	_growthLeft = capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR / FLATHASHMAP_LOADFACTOR_DENOMINATOR;
+
+	_ctrl = (byte *)malloc(capacity + FlatHashGroup::kWidth);
+	_slots = (Node *)malloc(capacity * sizeof(Node));
+	if (!_ctrl || !_slots)
+		error("Common::FlatHashMap: failure to allocate %u bytes", capacity * (uint)sizeof(Node));
+	memset(_ctrl, FlatHashGroup::kEmpty, capacity + FlatHashGroup::kWidth);
+}
+
+/**
+ * Internal method for freeing the storage. The nodes must have been
+ * destroyed already.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	free(_ctrl);
+	free(_slots);
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one. The slots are copied as they are, so no rehashing is needed.
+ *
+ * @note The previous storage here is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+	memcpy(_ctrl, map._ctrl, _mask + 1 + FlatHashGroup::kWidth);
+
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(_ctrl[ctr]))
+			new (&_slots[ctr]) Node(map._slots[ctr]);
+	}
+
+	_size = map._size;
+	_growthLeft = map._growthLeft;
+}
+
+/**
+ * Clear all values in the hashmap.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(_ctrl[ctr]))
+			_slots[ctr].~Node();
+	}
+
+	const size_type capacity = (shrinkArray ? (size_type)FLATHASHMAP_MIN_CAPACITY : _mask + 1);
+	if (capacity != _mask + 1) {
+		freeStorage();
+		allocStorage(capacity);
+	} else {
+		memset(_ctrl, FlatHashGroup::kEmpty, capacity + FlatHashGroup::kWidth);
+		_size = 0;
+		_growthLeft = capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR / FLATHASHMAP_LOADFACTOR_DENOMINATOR;
+	}
+}
+
+/**
+ * Internal method for moving all nodes into new storage of @p newCapacity
+ * slots. This also gets rid of all deleted slots.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+#ifndef NDEBUG
+	const size_type old_size = _size;
+#endif
+	const size_type old_mask = _mask;
+	byte *old_ctrl = _ctrl;
+	Node *old_slots = _slots;
+
+	allocStorage(newCapacity);
+
+	for (size_type ctr = 0; ctr <= old_mask; ++ctr) {
+		if (!isFull(old_ctrl[ctr]))
+			continue;
+
+		// Since we know that no key exists twice in the old table, the node
+		// can go straight into the first free slot, without calling _equal().
+		const size_type hash = mixHash(_hash(old_slots[ctr]._key));
+		const size_type idx = findFreeSlot(hash);
+		setCtrl(idx, h2(hash));
+		new (&_slots[idx]) Node(Common::move(old_slots[ctr]));
+		old_slots[ctr].~Node();
+		_size++;
+		_growthLeft--;
+	}
+
+	// Perform a sanity check: Old number of elements should match the new one!
+	// This check will fail if some previous operation corrupted this hashmap.
+	assert(_size == old_size);
+
+	free(old_ctrl);
+	free(old_slots);
+}
+
+/**
+ * Internal method returning the slot of @p key, or a value greater than
+ * _mask if the key is not present.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key, size_type hash) const {
+	const byte tag = h2(hash);
+	size_type pos = (hash >> 7) & _mask;
+	for (size_type stride = FlatHashGroup::kWidth; ; stride += FlatHashGroup::kWidth) {
+		const FlatHashGroup group(_ctrl + pos);
+		for (FlatHashGroup::Mask match = group.match(tag); match; match &= match - 1) {
+			const size_type ctr = (pos + FlatHashGroup::lowestIndex(match)) & _mask;
+			if (_equal(_slots[ctr]._key, key))
+				return ctr;
+		}
+
+		// An empty slot ends the probe sequence: the key would have gone there
+		if (group.matchEmpty())
+			return _mask + 1;
+
+		pos = (pos + stride) & _mask;
+	}
+}
+
+/**
+ * Internal method returning the first empty or deleted slot of the probe
+ * sequence of @p hash.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::findFreeSlot(size_type hash) const {
+	size_type pos = (hash >> 7) & _mask;
+	for (size_type stride = FlatHashGroup::kWidth; ; stride += FlatHashGroup::kWidth) {
+		const FlatHashGroup::Mask free = FlatHashGroup(_ctrl + pos).matchFree();
+		if (free)
+			return (pos + FlatHashGroup::lowestIndex(free)) & _mask;
+
+		pos = (pos + stride) & _mask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	const size_type hash = mixHash(_hash(key));
+	size_type ctr = lookup(key, hash);
+	if (ctr <= _mask)
+		return ctr;
+
+	ctr = findFreeSlot(hash);
+
+	// Deleted slots can always be reused, but an empty one may only be
+	// taken while the load factor permits it.
+	if (_growthLeft == 0 && _ctrl[ctr] == FlatHashGroup::kEmpty) {
+		// If more than half of the used slots are deleted ones, getting
+		// rid of those is enough.
+		size_type capacity = _mask + 1;
+		if (_size * 2 * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+			capacity *= 2;
+		rehash(capacity);
+		ctr = findFreeSlot(hash);
+	}
+
+	if (_ctrl[ctr] == FlatHashGroup::kEmpty)
+		_growthLeft--;
+	setCtrl(ctr, h2(hash));
+	new (&_slots[ctr]) Node(key);
+	_size++;
+
+	return ctr;
+}
+
+/**
+ * Check whether the hashmap contains the given key.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) <= _mask;
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getOrCreateVal(key);
+}
+
+/**
+ * @overload
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getOrCreateVal(const Key &key) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	return _slots[ctr]._value;
+}
+
+/**
+ * @overload
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask)
+		return _slots[ctr]._value;
+	else
+		// See comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask)
+		return _slots[ctr]._value;
+	else
+		// See comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key) const {
+	return getValOrDefault(key, _defaultVal);
+}
+
+/**
+ * Get a value from the hashmap. If the key is not present, then return @p defaultVal.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask)
+		return _slots[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::tryGetVal(const Key &key, Val &out) const {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask) {
+		out = _slots[ctr]._value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * Assign an element specified by @p key to a value @p val.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	_slots[ctr]._value = val;
+}
+
+/**
+ * Erase an element referred to by an iterator.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	const size_type ctr = entry._idx;
+	assert(ctr <= _mask);
+	assert(isFull(_ctrl[ctr]));
+
+	// The slot is marked as deleted rather than empty, so that probe
+	// sequences passing through it continue past it.
+	_slots[ctr].~Node();
+	setCtrl(ctr, FlatHashGroup::kDeleted);
+	_size--;
+}
+
+/**
+ * Erase an element specified by a key.
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr > _mask)
+		return;
+
+	erase(iterator(ctr, this));
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -93,6 +93,13 @@ public:
 	int64 size() const { return _size; }
 
 	bool seek(int64 offs, int whence = SEEK_SET);
+
+	/**
+	 * Returns the memory buffer the stream reads from, so that callers can
+	 * parse it in place instead of copying it. It is only valid for as long
+	 * as the stream exists.
+	 */
+	const byte *getData() const { return _ptrOrig.get(); }
 };
 
 
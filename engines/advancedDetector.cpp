@@ -373,13 +373,15 @@ Common::Error AdvancedMetaEngineDetection::createInstance(OSystem *syst, Engine
 	// the _directoryGlobsMap
 	preprocessDescriptions();
 
+	// Clear md5 cache before each detection starts, just in case. This also
+	// drops directory listings cached by an earlier detection, the game
+	// directory may have changed since then.
+	ADCacheMan.clear();
+
 	// Compose a hashmap of all files in fslist.
 	FileMap allFiles;
 	composeFileHashMap(allFiles, files, (_maxScanDepth == 0 ? 1 : _maxScanDepth));
 
-	// Clear md5 cache before each detection starts, just in case.
-	ADCacheMan.clear();
-
 	// Run the detector on this
 	ADDetectedGames matches = detectGame(files.begin()->getParent(), allFiles, language, platform, extra);
 
@@ -491,7 +493,7 @@ void AdvancedMetaEngineDetection::composeFileHashMap(FileMap &allFiles, const Co
 				continue;
 
 			Common::FSList files;
-			if (!file->getChildren(files, Common::FSNode::kListAll))
+			if (!ADCacheMan.getChildren(*file, files))
 				continue;
 
 			composeFileHashMap(allFiles, files, depth - 1, tstr);
@@ -582,9 +584,15 @@ Common::String md5PropToGameFile(MD5Properties flags) {
 static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngine::FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps);
 
 bool AdvancedMetaEngineDetection::getFileProperties(const FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) const {
+	// Engines scanning to different depths may map the same name to
+	// different files, so plain files are cached by their actual path
+	FileMap::const_iterator file = allFiles.end();
+	if (!(md5prop & (kMD5Archive | kMD5MacResFork | kMD5MacDataFork)))
+		file = allFiles.find(fname);
+
 	Common::String hashname = md5PropToCachePrefix(md5prop);
 		hashname += ':';
-		hashname += fname.toString('/');
+		hashname += (file != allFiles.end() ? file->_value.getPath() : fname).toString('/');
 		hashname += ':';
 		hashname += Common::String::format("%d", _md5Bytes);
 
@@ -571,7 +571,7 @@ protected:
 };
 
 /**
- * Singleton Cache Storage for Computed MD5s and Open Archives
+ * Singleton Cache Storage for Computed MD5s, Directory Listings and Open Archives
  */
 class AdvancedDetectorCacheManager : public Common::Singleton<AdvancedDetectorCacheManager> {
 public:
@@ -612,15 +612,42 @@ public:
 		return archiveHashMap.getValOrDefault(node.getPath(), nullptr);
 	}
 
+	/**
+	 * Lists the contents of a directory. The listing is shared by all the
+	 * engines detecting games in the same directories, so that each one
+	 * does not walk the file system again.
+	 */
+	bool getChildren(const Common::FSNode &node, Common::FSList &files) {
+		Common::Path path = node.getPath();
+
+		DirectoryHashMap::const_iterator entry = directoryHashMap.find(path);
+		if (entry != directoryHashMap.end()) {
+			files = entry->_value;
+			return true;
+		}
+
+		if (!node.getChildren(files, Common::FSNode::kListAll))
+			return false;
+
+		directoryHashMap.setVal(path, files);
+		return true;
+	}
+
 	AdvancedDetectorCacheManager() {
 		clear();
 	}
 
+	/**
+	 * Drops what is only valid for the detection that filled it: the open
+	 * archives and the directory listings, which may be stale by the time
+	 * the next detection runs.
+	 */
 	void clearArchives() {
 		for (auto &entry : archiveHashMap) {
 			delete entry._value;
 		}
 		archiveHashMap.clear(true);
+		directoryHashMap.clear(true);
 	}
 
 	void clear() {
@@ -635,9 +662,13 @@ private:
 	typedef Common::HashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileHashMap;
 	typedef Common::HashMap<Common::String, int64, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SizeHashMap;
 	typedef Common::HashMap<Common::Path, Common::Archive *, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> ArchiveHashMap;
+	// Keyed on the exact path: "Data" and "data" are different directories
+	// on case sensitive file systems
+	typedef Common::HashMap<Common::Path, Common::FSList, Common::Path::Hash> DirectoryHashMap;
 	FileHashMap md5HashMap;
 	SizeHashMap sizeHashMap;
 	ArchiveHashMap archiveHashMap;
+	DirectoryHashMap directoryHashMap;
 };
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
@@ -259,6 +259,7 @@ ccInstance::ccInstance() {
 	numimports = 0;
 	resolved_imports = nullptr;
 	code_fixups         = nullptr;
+	linked_values       = nullptr;
 
 	memset(callStackLineNumber, 0, sizeof(callStackLineNumber));
 	memset(callStackAddr, 0, sizeof(callStackAddr));
@@ -487,65 +488,33 @@ int ccInstance::Run(int32_t curpc) {
 			return -1;
 		}
 
+		// Arguments point either to the values prepared by LinkCode(), or to
+		// codeOp.Args for the ones that have to be resolved right now
+		const RuntimeScriptValue *args[MAX_SCMD_ARGS] = { &codeOp.Args[0], &codeOp.Args[1], &codeOp.Args[2] };
 		int pc_at = pc + 1;
 		for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
-			char fixup = codeInst->code_fixups[pc_at];
-			if (fixup > 0) {
-				// could be relative pointer or import address
-				/*
-				if (!FixupArgument(code[pc], fixup, codeOp.Args[i]))
-				{
-				    return -1;
-				}
-				*/
-				/* FixupArgument */
-				//=====================================================================
-				switch (fixup) {
-				case FIXUP_GLOBALDATA: {
-					ScriptVariable *gl_var = (ScriptVariable *)codeInst->code[pc_at];
-					codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
-				}
-				break;
-				case FIXUP_FUNCTION:
-					// originally commented -- CHECKME: could this be used in very old versions of AGS?
-					//      code[fixup] += (long)&code[0];
-					// This is a program counter value, presumably will be used as SCMD_CALL argument
-					codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
-					break;
-				case FIXUP_STRING:
-					codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeInst->code[pc_at]);
-					break;
-				case FIXUP_IMPORT: {
-					const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(codeInst->code[pc_at]));
-					if (import) {
-						codeOp.Args[i] = import->Value;
-					} else {
-						cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
-						return -1;
-					}
-				}
-				break;
-				case FIXUP_STACK:
-					codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
-					break;
-				default:
-					cc_error("internal fixup type error: %d", fixup);
+			const char fixup = codeInst->code_fixups[pc_at];
+			if (fixup == FIXUP_IMPORT) {
+				const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(codeInst->code[pc_at]));
+				if (import) {
+					codeOp.Args[i] = import->Value;
+				} else {
+					cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
 					return -1;
 				}
-				/* End FixupArgument */
-				//=====================================================================
+			} else if (fixup == FIXUP_STACK) {
+				codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
 			} else {
-				// should be a numeric literal (int32 or float)
-				codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
+				args[i] = &codeInst->linked_values[codeInst->code[pc_at]];
 			}
 		}
 		/* End ReadOperation */
 		//=====================================================================
 
 		// save the arguments for quick access
-		RuntimeScriptValue &arg1 = codeOp.Args[0];
-		RuntimeScriptValue &arg2 = codeOp.Args[1];
-		RuntimeScriptValue &arg3 = codeOp.Args[2];
+		const RuntimeScriptValue &arg1 = *args[0];
+		const RuntimeScriptValue &arg2 = *args[1];
+		const RuntimeScriptValue &arg3 = *args[2];
 		RuntimeScriptValue &reg1 =
 		    registers[arg1.IValue >= 0 && arg1.IValue < CC_NUM_REGISTERS ? arg1.IValue : 0];
 		RuntimeScriptValue &reg2 =
@@ -555,6 +524,10 @@ int ccInstance::Run(int32_t curpc) {
 		const char *direct_ptr2;
 
 		if (write_debug_dump) {
+			for (int i = 0; i < codeOp.ArgCount; ++i) {
+				if (args[i] != &codeOp.Args[i])
+					codeOp.Args[i] = *args[i];
+			}
 			DumpInstruction(codeOp);
 		}
 
@@ -1431,6 +1404,7 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		linked_values = joined->linked_values;
 	} else {
 		if (!CreateGlobalVars(scri.get())) {
 			return false;
@@ -1438,6 +1412,9 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 		if (!CreateRuntimeCodeFixups(scri.get())) {
 			return false;
 		}
+		if (!LinkCode()) {
+			return false;
+		}
 	}
 
 	exports = new RuntimeScriptValue[scri->numexports];
@@ -1513,9 +1490,11 @@ void ccInstance::Free() {
 	if ((flags & INSTF_SHAREDATA) == 0) {
 		delete[] resolved_imports;
 		delete[] code_fixups;
+		delete[] linked_values;
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	linked_values = nullptr;
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1708,6 +1687,63 @@ bool ccInstance::CreateRuntimeCodeFixups(const ccScript *scri) {
 	return true;
 }
 
+bool ccInstance::LinkCode() {
+	// Numeric literals repeat a lot (register numbers, sizes, small constants),
+	// so every distinct one is stored only once
+	std::vector<RuntimeScriptValue> values;
+	std::unordered_map<int32_t, uint32_t> literals;
+	for (int32_t at = 0; at < codesize; ) {
+		const int op = code[at] & INSTANCE_ID_REMOVEMASK;
+		if (op < 0 || op >= CC_NUM_SCCMDS) {
+			cc_error("invalid instruction %d found in code stream", op);
+			return false;
+		}
+
+		// The index of the value replaces the operand in the code, only
+		// imports and stack offsets keep theirs
+		const int32_t argEnd = MIN<int32_t>(at + 1 + (*g_commands)[op].ArgCount, codesize);
+		for (int32_t i = at + 1; i < argEnd; ++i) {
+			RuntimeScriptValue value;
+			switch (code_fixups[i]) {
+			case FIXUP_GLOBALDATA:
+				value.SetGlobalVar(&((ScriptVariable *)code[i])->RValue);
+				break;
+			case FIXUP_STRING:
+				value.SetStringLiteral(&strings[0] + code[i]);
+				break;
+			case FIXUP_IMPORT:
+			case FIXUP_STACK:
+				continue; // resolved when executed
+			case 0:
+			case FIXUP_FUNCTION: {
+				// numeric literal (int32 or float), or a program counter
+				// value, which is used as a plain number as well
+				const int32_t literal = (int32_t)code[i];
+				std::unordered_map<int32_t, uint32_t>::const_iterator it = literals.find(literal);
+				if (it != literals.end()) {
+					code[i] = it->_value;
+					continue;
+				}
+				literals[literal] = values.size();
+				value.SetInt32(literal);
+			}
+			break;
+			default:
+				cc_error("internal fixup type error: %d", code_fixups[i]);
+				return false;
+			}
+			code[i] = values.size();
+			values.push_back(value);
+		}
+		at = argEnd;
+	}
+
+	linked_values = new RuntimeScriptValue[values.size()];
+	for (size_t i = 0; i < values.size(); ++i)
+		linked_values[i] = values[i];
+	return true;
+}
+
 bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 	for (int fixup_idx = 0; fixup_idx < scri->numfixups; ++fixup_idx) {
 		if (scri->fixuptypes[fixup_idx] != FIXUP_IMPORT)
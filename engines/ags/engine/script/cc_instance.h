@@ -139,6 +139,10 @@ public:
 	int  numimports;
 
 	char *code_fixups;
+	// Operands resolved once at load time by LinkCode(). The operands in the
+	// code are replaced with their index in this array, except for stack
+	// offsets and imports, which depend on the state at the time of the call.
+	RuntimeScriptValue *linked_values;
 
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
@@ -193,6 +197,9 @@ private:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
+	// Prepare the operand values that do not change at run time, see
+	// linked_values
+	bool    LinkCode();
 	//bool    ReadOperation(ScriptOperation &op, int32_t at_pc);
 
 	// Begin executing script starting from the given bytecode index
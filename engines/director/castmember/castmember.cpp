@@ -237,12 +237,10 @@ bool CastMember::setField(int field, const Datum &d) {
 		_purgePriority = CLIP<int>(d.asInt(), 0, 3);
 		return true;
 	case kTheScriptText:
-		if (!castInfo) {
-			warning("CastMember::setField(): CastMember info for %d not found", _castId);
-			return false;
-		}
+		// Members without an info entry can still get a script
 		_cast->_lingoArchive->replaceCode(*d.u.s, kCastScript, _castId);
-		castInfo->script = d.asString();
+		if (castInfo)
+			castInfo->script = d.asString();
 		return true;
 	case kTheWidth:
 		warning("BUILDBOT: CastMember::setField(): Attempt to set read-only field \"%s\" of cast %d", g_lingo->field2str(field), _castId);
@@ -2026,6 +2026,7 @@ void LB::b_clearGlobals(int nargs) {
 			g_lingo->_globalvars.erase(it._key);
 		}
 	}
+	Lingo::invalidateCaches();
 }
 
 void LB::b_cursor(int nargs) {
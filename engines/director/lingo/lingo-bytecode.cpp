@@ -77,9 +77,9 @@ static LingoV4Bytecode lingoV4[] = {
 	// 0x44, push a constant
 	{ 0x45, LC::c_namepush,		"bN" },
 	{ 0x46, LC::cb_varrefpush,  "bN" },
-	{ 0x48, LC::cb_globalpush,	"bN" }, // used in event scripts
-	{ 0x49, LC::cb_globalpush,	"bN" },
-	{ 0x4a, LC::cb_thepush,		"bN" },
+	{ 0x48, LC::cb_globalpush,	"bNC" }, // used in event scripts
+	{ 0x49, LC::cb_globalpush,	"bNC" },
+	{ 0x4a, LC::cb_thepush,		"bNC" },
 	{ 0x4b, LC::cb_varpush,		"bpaN" },
 	{ 0x4c, LC::cb_varpush,		"bpvN" },
 	{ 0x4e, LC::cb_globalassign,"bN" }, // used in event scripts
@@ -90,8 +90,8 @@ static LingoV4Bytecode lingoV4[] = {
 	{ 0x53, LC::c_jump,			"jb" },
 	{ 0x54, LC::c_jump,			"jbn" },
 	{ 0x55, LC::c_jumpifz,		"jb" },
-	{ 0x56, LC::cb_localcall,	"b" },
-	{ 0x57, LC::cb_call,		"bN" },
+	{ 0x56, LC::cb_localcall,	"bC" },
+	{ 0x57, LC::cb_call,		"bNC" },
 	{ 0x58, LC::cb_objectcall,  "b" },
 	{ 0x59, LC::cb_v4assign,	"b" },
 	{ 0x5a, LC::cb_v4assign2,	"b" },
@@ -100,9 +100,9 @@ static LingoV4Bytecode lingoV4[] = {
 	{ 0x5d, LC::cb_v4theentityassign, "b" },
 	{ 0x5f, LC::cb_thepush2,	"bN" },
 	{ 0x60, LC::cb_theassign2,	"bN" },
-	{ 0x61, LC::cb_objectfieldpush, "bN" },
+	{ 0x61, LC::cb_objectfieldpush, "bNC" },
 	{ 0x62, LC::cb_objectfieldassign, "bN" },
-	{ 0x63, LC::cb_call,		"bN" }, // tellcall
+	{ 0x63, LC::cb_call,		"bNC" }, // tellcall
 	{ 0x64, LC::c_stackpeek, 	"b" },
 	{ 0x65, LC::c_stackdrop, 	"b" },
 	{ 0x66, LC::cb_v4theentitynamepush, "bN" },
@@ -113,9 +113,9 @@ static LingoV4Bytecode lingoV4[] = {
 	// 0x84, push a constant
 	{ 0x85, LC::c_namepush,		"wN" },
 	{ 0x86, LC::cb_varrefpush,  "wN" },
-	{ 0x88, LC::cb_globalpush,	"wN" }, // used in event scripts
-	{ 0x89, LC::cb_globalpush,	"wN" },
-	{ 0x8a, LC::cb_thepush,		"wN" },
+	{ 0x88, LC::cb_globalpush,	"wNC" }, // used in event scripts
+	{ 0x89, LC::cb_globalpush,	"wNC" },
+	{ 0x8a, LC::cb_thepush,		"wNC" },
 	{ 0x8b, LC::cb_varpush,		"wpaN" },
 	{ 0x8c, LC::cb_varpush,		"wpvN" },
 	{ 0x8e, LC::cb_globalassign,"wN" }, // used in event scripts
@@ -126,8 +126,8 @@ static LingoV4Bytecode lingoV4[] = {
 	{ 0x93, LC::c_jump,			"jw" },
 	{ 0x94, LC::c_jump,			"jwn" },
 	{ 0x95, LC::c_jumpifz,		"jw" },
-	{ 0x96, LC::cb_localcall,	"w" },
-	{ 0x97, LC::cb_call,		"wN" },
+	{ 0x96, LC::cb_localcall,	"wC" },
+	{ 0x97, LC::cb_call,		"wNC" },
 	{ 0x98, LC::cb_objectcall,  "w" },
 	{ 0x99, LC::cb_v4assign,	"w" },
 	{ 0x9a, LC::cb_v4assign2,	"w" },
@@ -135,9 +135,9 @@ static LingoV4Bytecode lingoV4[] = {
 	{ 0x9d, LC::cb_v4theentityassign, "w" },
 	{ 0x9f, LC::cb_thepush2, 	"wN" },
 	{ 0xa0, LC::cb_theassign2, "wN" },
-	{ 0xa1, LC::cb_objectfieldpush, "wN" },
+	{ 0xa1, LC::cb_objectfieldpush, "wNC" },
 	{ 0xa2, LC::cb_objectfieldassign, "wN" },
-	{ 0xa3, LC::cb_call,		"wN" }, // tellcall
+	{ 0xa3, LC::cb_call,		"wNC" }, // tellcall
 	{ 0xa4, LC::c_stackpeek, 	"w" },
 	{ 0xa5, LC::c_stackdrop, 	"w" },
 	{ 0xa6, LC::cb_v4theentitynamepush, "wN" },
@@ -423,13 +423,15 @@ void LC::cb_hilite() {
 void LC::cb_localcall() {
 	int functionId = g_lingo->readInt();
 
+	InlineCache *cache = g_lingo->readInlineCache();
+
 	Datum nargs = g_lingo->pop();
 	if ((nargs.type == ARGC) || (nargs.type == ARGCNORET)) {
 		Common::String name = g_lingo->_state->context->_functionNames[functionId];
 		if (debugChannelSet(3, kDebugLingoExec))
 			g_lingo->printArgs(name.c_str(), nargs.u.i, "localcall:");
 
-		LC::call(name, nargs.u.i, nargs.type == ARGC);
+		LC::call(name, nargs.u.i, nargs.type == ARGC, cache);
 
 	} else {
 		warning("cb_localcall: first arg should be of type ARGC or ARGCNORET, not %s", nargs.type2str());
@@ -537,10 +539,11 @@ void LC::cb_proplist() {
 
 void LC::cb_call() {
 	Common::String name = g_lingo->readString();
+	InlineCache *cache = g_lingo->readInlineCache();
 
 	Datum nargs = g_lingo->pop();
 	if ((nargs.type == ARGC) || (nargs.type == ARGCNORET)) {
-		LC::call(name, nargs.u.i, nargs.type == ARGC);
+		LC::call(name, nargs.u.i, nargs.type == ARGC, cache);
 
 	} else {
 		warning("cb_call: first arg should be of type ARGC or ARGCNORET, not %s", nargs.type2str());
@@ -551,9 +554,18 @@ void LC::cb_call() {
 
 void LC::cb_globalpush() {
 	Common::String name = g_lingo->readString();
+	InlineCache *cache = g_lingo->readInlineCache();
+	debugC(3, kDebugLingoExec, "cb_globalpush: pushing %s to stack", name.c_str());
+
+	Datum *value = g_lingo->findGlobal(cache, name);
+	if (value) {
+		g_debugger->varReadHook(name);
+		g_lingo->push(*value);
+		return;
+	}
+
 	Datum target(name);
 	target.type = GLOBALREF;
-	debugC(3, kDebugLingoExec, "cb_globalpush: pushing %s to stack", name.c_str());
 	Datum result = g_lingo->varFetch(target);
 	g_lingo->push(result);
 }
@@ -577,7 +589,18 @@ void LC::cb_objectfieldassign() {
 
 void LC::cb_objectfieldpush() {
 	Common::String fieldName = g_lingo->readString();
+	InlineCache *cache = g_lingo->readInlineCache();
 	Datum object = g_lingo->pop();
+
+	if (object.type == OBJECT) {
+		Datum *value = g_lingo->findProp(cache, object.u.obj, fieldName);
+		if (value) {
+			g_lingo->push(*value);
+			g_debugger->propReadHook(fieldName);
+			return;
+		}
+	}
+
 	g_lingo->getObjectProp(object, fieldName);
 }
 
@@ -620,7 +643,15 @@ void LC::cb_theassign2() {
 
 void LC::cb_thepush() {
 	Common::String name = g_lingo->readString();
+	InlineCache *cache = g_lingo->readInlineCache();
 	if (g_lingo->_state->me.type == OBJECT) {
+		Datum *value = g_lingo->findProp(cache, g_lingo->_state->me.u.obj, name);
+		if (value) {
+			g_lingo->push(*value);
+			g_debugger->propReadHook(name);
+			return;
+		}
+
 		if (g_lingo->_state->me.u.obj->hasProp(name)) {
 			g_lingo->push(g_lingo->_state->me.u.obj->getProp(name));
 			g_debugger->propReadHook(name);
@@ -1480,6 +1511,7 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 				size_t argc = strlen(g_lingo->_lingoV4[opcode]->proto);
 				if (argc) {
 					bool codeName = false;
+					bool codeCache = false;
 					int arg = 0;
 					for (uint c = 0; c < argc; c++) {
 						switch (g_lingo->_lingoV4[opcode]->proto[c]) {
@@ -1552,6 +1584,10 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 							// argument is a name in the name table
 							codeName = true;
 							break;
+						case 'C':
+							// instruction has an inline cache
+							codeCache = true;
+							break;
 						default:
 							break;
 						}
@@ -1561,6 +1597,8 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 					} else {
 						codeInt(arg);
 					}
+					if (codeCache)
+						codeInlineCache();
 				}
 			} else {
 				// unimplemented instruction
@@ -1658,6 +1696,7 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 			}
 		}
 	}
+	Lingo::invalidateCaches();
 
 	if (!skipdump && ConfMan.getBool("dump_scripts")) {
 		out.flush();
@@ -74,8 +74,8 @@ static struct FuncDescr {
 	{ LC::c_argcpush,		"c_argcpush",		"i" },
 	{ LC::c_arraypush,		"c_arraypush",		"i" },
 	{ LC::c_assign,			"c_assign",			""  },
-	{ LC::c_callcmd,		"c_callcmd",		"si" },
-	{ LC::c_callfunc,		"c_callfunc",		"si" },
+	{ LC::c_callcmd,		"c_callcmd",		"siC" },
+	{ LC::c_callfunc,		"c_callfunc",		"siC" },
 	{ LC::c_charToOf,		"c_charToOf",		"" },	// D3
 	{ LC::c_charToOfRef,	"c_charToOfRef",	"" },	// D3
 	{ LC::c_concat,			"c_concat",			"" },
@@ -88,7 +88,7 @@ static struct FuncDescr {
 	{ LC::c_fieldref,		"c_fieldref",		"" },
 	{ LC::c_floatpush,		"c_floatpush",		"f" },
 	{ LC::c_globalinit,		"c_globalinit",		"s" },
-	{ LC::c_globalpush,		"c_globalpush",		"s" },
+	{ LC::c_globalpush,		"c_globalpush",		"sC" },
 	{ LC::c_globalrefpush,	"c_globalrefpush",	"s" },
 	{ LC::c_ge,				"c_ge",				"" },
 	{ LC::c_gt,				"c_gt",				"" },
@@ -112,7 +112,7 @@ static struct FuncDescr {
 	{ LC::c_neq,			"c_neq",			"" },
 	{ LC::c_not,			"c_not",			"" },
 	{ LC::c_objectpropassign,"c_objectpropassign","s" }, // prop
-	{ LC::c_objectproppush,	"c_objectproppush","s" }, // prop
+	{ LC::c_objectproppush,	"c_objectproppush","sC" }, // prop
 	{ LC::c_of,				"c_of",				"" },
 	{ LC::c_or,				"c_or",				"" },
 	{ LC::c_procret,		"c_procret",		"" },
@@ -139,21 +139,21 @@ static struct FuncDescr {
 	{ LC::c_wordToOf,		"c_wordToOf",		"" },	// D3
 	{ LC::c_wordToOfRef,	"c_wordToOfRef",	"" },	// D3
 	{ LC::c_xpop,			"c_xpop",			""  },
-	{ LC::cb_call,			"cb_call",			"s" },
+	{ LC::cb_call,			"cb_call",			"sC" },
 	{ LC::cb_delete,		"cb_delete",		"i" },
 	{ LC::cb_hilite,		"cb_hilite",		"" },
 	{ LC::cb_globalassign,	"cb_globalassign",	"s" },
-	{ LC::cb_globalpush,	"cb_globalpush",	"s" },
+	{ LC::cb_globalpush,	"cb_globalpush",	"sC" },
 	{ LC::cb_list,			"cb_list",			"" },
 	{ LC::cb_proplist,		"cb_proplist",		"" },
-	{ LC::cb_localcall,		"cb_localcall",		"i" },
+	{ LC::cb_localcall,		"cb_localcall",		"iC" },
 	{ LC::cb_objectcall,	"cb_objectcall",	"i" },
 	{ LC::cb_objectfieldassign, "cb_objectfieldassign", "s" },
-	{ LC::cb_objectfieldpush, "cb_objectfieldpush", "s" },
+	{ LC::cb_objectfieldpush, "cb_objectfieldpush", "sC" },
 	{ LC::cb_varrefpush,	"cb_varrefpush",	"s" },
 	{ LC::cb_theassign,		"cb_theassign",		"s" },
 	{ LC::cb_theassign2,	"cb_theassign2",	"s" },
-	{ LC::cb_thepush,		"cb_thepush",		"s" },
+	{ LC::cb_thepush,		"cb_thepush",		"sC" },
 	{ LC::cb_thepush2,		"cb_thepush2",		"s" },
 	{ LC::cb_unk,			"cb_unk",			"i" },
 	{ LC::cb_unk1,			"cb_unk1",			"ii" },
@@ -523,8 +523,18 @@ void LC::c_varpush() {
 }
 
 void LC::c_globalpush() {
-	LC::c_globalrefpush();
-	Datum d = g_lingo->pop();
+	Common::String name(g_lingo->readString());
+	InlineCache *cache = g_lingo->readInlineCache();
+
+	Datum *value = g_lingo->findGlobal(cache, name);
+	if (value) {
+		g_debugger->varReadHook(name);
+		g_lingo->push(*value);
+		return;
+	}
+
+	Datum d(name);
+	d.type = GLOBALREF;
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
@@ -645,6 +655,16 @@ void LC::c_theentityassign() {
 void LC::c_objectproppush() {
 	Datum obj = g_lingo->pop();
 	Common::String propName = g_lingo->readString();
+	InlineCache *cache = g_lingo->readInlineCache();
+
+	if (obj.type == OBJECT) {
+		Datum *value = g_lingo->findProp(cache, obj.u.obj, propName);
+		if (value) {
+			g_lingo->push(*value);
+			g_debugger->propReadHook(propName);
+			return;
+		}
+	}
 
 	g_lingo->getObjectProp(obj, propName);
 }
@@ -1518,19 +1538,21 @@ void LC::c_callcmd() {
 	Common::String name(g_lingo->readString());
 
 	int nargs = g_lingo->readInt();
+	InlineCache *cache = g_lingo->readInlineCache();
 
-	LC::call(name, nargs, false);
+	LC::call(name, nargs, false, cache);
 }
 
 void LC::c_callfunc() {
 	Common::String name(g_lingo->readString());
 
 	int nargs = g_lingo->readInt();
+	InlineCache *cache = g_lingo->readInlineCache();
 
-	LC::call(name, nargs, true);
+	LC::call(name, nargs, true, cache);
 }
 
-void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
+void LC::call(const Common::String &name, int nargs, bool allowRetVal, InlineCache *cache) {
 	if (debugChannelSet(3, kDebugLingoExec))
 		g_lingo->printArgs(name.c_str(), nargs, "call:");
 
@@ -1568,8 +1590,10 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 			AbstractObject *target = firstArg.u.obj;
 			if (name.equalsIgnoreCase("birth") || name.equalsIgnoreCase("new")) {
 				target = target->clone();
+				funcSym = target->getMethod(name);
+			} else if (!cache || !g_lingo->findMethod(cache, target, name, funcSym)) {
+				funcSym = target->getMethod(name);
 			}
-			funcSym = target->getMethod(name);
 			if (funcSym.type != VOIDSYM) {
 				g_lingo->_stack[g_lingo->_stack.size() - nargs] = target; // Set first arg to target
 				call(funcSym, nargs, allowRetVal);
@@ -1585,7 +1609,8 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 	// If there are no arguments at all, one will be added.
 	if (g_lingo->_state->me.type == OBJECT) {
 		AbstractObject *target = g_lingo->_state->me.u.obj;
-		funcSym = target->getMethod(name);
+		if (!cache || !g_lingo->findMethod(cache, target, name, funcSym))
+			funcSym = target->getMethod(name);
 		if (funcSym.type != VOIDSYM) {
 			if (nargs == 0) {
 				debugC(3, kDebugLingoExec, "Factory method call detected with missing first arg");
@@ -1601,30 +1626,49 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 	}
 
 	// Handler
-	funcSym = g_lingo->getHandler(name);
+	InlineCache lookup;
+	Movie *movie = g_director->getCurrentMovie();
+	if (!cache || !g_lingo->isCacheValid(cache, g_lingo->_state->context, movie)) {
+		if (!cache)
+			cache = &lookup;
+		g_lingo->bindCache(cache, g_lingo->_state->context, movie);
+		cache->handler = g_lingo->findHandler(name);
+
+		SymbolHash::const_iterator it = g_lingo->_builtinListHandlers.find(name);
+		if (it != g_lingo->_builtinListHandlers.end())
+			cache->listBuiltin = &it->_value;
+
+		it = g_lingo->_builtinCmds.find(name);
+		if (it != g_lingo->_builtinCmds.end())
+			cache->builtinCmd = &it->_value;
+
+		it = g_lingo->_builtinFuncs.find(name);
+		if (it != g_lingo->_builtinFuncs.end())
+			cache->builtinFunc = &it->_value;
+	}
+
+	if (cache->handler) {
+		funcSym = *cache->handler;
+	} else {
+		funcSym = Symbol();
+		funcSym.name = new Common::String(name);
+	}
 
-	if (g_lingo->_builtinListHandlers.contains(name) && nargs >= 1) {
+	if (nargs >= 1 && cache->listBuiltin) {
 		// Lingo builtin functions in the "List" category have very strange override mechanics.
 		// If the first argument is an ARRAY or PARRAY, it will use the builtin.
 		// Otherwise, it will fall back to whatever handler is defined globally.
 		Datum firstArg = g_lingo->peek(nargs - 1);
 		if (firstArg.type == ARRAY || firstArg.type == PARRAY ||
 				firstArg.type == POINT || firstArg.type == RECT) {
-			funcSym = g_lingo->_builtinListHandlers[name];
+			funcSym = *cache->listBuiltin;
 		}
 	}
 
-	if (funcSym.type == VOIDSYM) { // The built-ins could be overridden
+	const Symbol *builtin = allowRetVal ? cache->builtinFunc : cache->builtinCmd;
+	if (funcSym.type == VOIDSYM && builtin) { // The built-ins could be overridden
 		// Builtin
-		if (allowRetVal) {
-			if (g_lingo->_builtinFuncs.contains(name)) {
-				funcSym = g_lingo->_builtinFuncs[name];
-			}
-		} else {
-			if (g_lingo->_builtinCmds.contains(name)) {
-				funcSym = g_lingo->_builtinCmds[name];
-			}
-		}
+		funcSym = *builtin;
 	}
 
 	// use lingo-the as fallback. we can only use functions as fallback, not properties
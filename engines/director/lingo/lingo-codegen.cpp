@@ -254,6 +254,7 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 			}
 		}
 	}
+	Lingo::invalidateCaches();
 
 	delete _methodVars;
 	_methodVars = nullptr;
@@ -305,6 +306,16 @@ int LingoCompiler::codeFloat(double f) {
 	return _currentAssembly->size();
 }
 
+int LingoCompiler::codeInlineCache() {
+	int numInsts = calcCodeAlignment(sizeof(InlineCache));
+
+	// An empty cache, bound on first execution
+	for (int i = 0; i < numInsts; i++)
+		_currentAssembly->push_back(0);
+
+	return _currentAssembly->size();
+}
+
 int LingoCompiler::codeInt(int val) {
 	inst i = nullptr;
 	WRITE_UINT32(&i, val);
@@ -321,6 +332,7 @@ int LingoCompiler::codeCmd(const Common::String &s, int numpar) {
 	inst num = nullptr;
 	WRITE_UINT32(&num, numpar);
 	code1(num);
+	codeInlineCache();
 
 	return ret;
 }
@@ -333,6 +345,7 @@ int LingoCompiler::codeFunc(const Common::String &s, int numpar) {
 	inst num = nullptr;
 	WRITE_UINT32(&num, numpar);
 	code1(num);
+	codeInlineCache();
 
 	return ret;
 }
@@ -395,6 +408,8 @@ void LingoCompiler::codeVarGet(const Common::String &name) {
 		break;
 	}
 	codeString(name.c_str());
+	if (type == kVarGlobal)
+		codeInlineCache();
 }
 
 void LingoCompiler::registerMethodVar(const Common::String &name, VarType type) {
@@ -1480,6 +1495,7 @@ bool LingoCompiler::visitTheOfNode(TheOfNode *node) {
 		COMPILE(node->obj);
 		code1(LC::c_objectproppush);
 		codeString(node->prop->c_str());
+		codeInlineCache();
 		return true;
 	}
 
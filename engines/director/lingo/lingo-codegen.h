@@ -43,6 +43,7 @@ public:
 	int codeCmd(const Common::String &s, int numpar);
 	int codeFloat(double f);
 	int codeFunc(const Common::String &s, int numpar);
+	int codeInlineCache();
 	int codeInt(int val);
 	int codeString(const char *s);
 	void codeVarSet(const Common::String &name);
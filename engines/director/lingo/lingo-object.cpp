@@ -449,6 +449,12 @@ ScriptContext::ScriptContext(const ScriptContext &sc) : Object<ScriptContext>(sc
 }
 
 ScriptContext::~ScriptContext() {
+	Lingo::invalidateCaches();
+}
+
+void ScriptContext::dispose() {
+	_disposed = true;
+	Lingo::invalidateCaches();
 }
 
 Common::String ScriptContext::asString() {
@@ -472,6 +478,7 @@ Symbol ScriptContext::define(const Common::String &name, ScriptData *code, Commo
 	}
 
 	_functionHandlers[name] = sym;
+	Lingo::invalidateCaches();
 	if (g_lingo->_eventHandlerTypeIds.contains(name)) {
 		_eventHandlers[g_lingo->_eventHandlerTypeIds[name]] = sym;
 	}
@@ -479,11 +486,24 @@ Symbol ScriptContext::define(const Common::String &name, ScriptData *code, Commo
 	return sym;
 }
 
+AbstractObject *ScriptContext::getAncestor() {
+	if (_objType != kScriptObj)
+		return nullptr;
+
+	DatumHash::iterator it = _properties.find("ancestor");
+	if (it == _properties.end() || it->_value.type != OBJECT
+			|| !(it->_value.u.obj->getObjType() & (kScriptObj | kXtraObj)))
+		return nullptr;
+
+	return it->_value.u.obj;
+}
+
 Symbol ScriptContext::getMethod(const Common::String &methodName) {
 	Symbol sym;
 
-	if (_functionHandlers.contains(methodName)) {
-		sym = _functionHandlers[methodName];
+	SymbolHash::iterator it = _functionHandlers.find(methodName);
+	if (it != _functionHandlers.end()) {
+		sym = it->_value;
 		sym.target = this;
 		return sym;
 	}
@@ -492,19 +512,38 @@ Symbol ScriptContext::getMethod(const Common::String &methodName) {
 	if (sym.type != VOIDSYM)
 		return sym;
 
-	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			// ancestor method
-			sym = _properties["ancestor"].u.obj->getMethod(methodName);
-			if (sym.type != VOIDSYM)
-				debugC(3, kDebugLingoExec, "Calling method '%s' on ancestor: <%s>", methodName.c_str(), _properties["ancestor"].asString(true).c_str());
-		}
+	AbstractObject *ancestor = getAncestor();
+	if (ancestor) {
+		// ancestor method
+		sym = ancestor->getMethod(methodName);
+		if (sym.type != VOIDSYM)
+			debugC(3, kDebugLingoExec, "Calling method '%s' on ancestor: <%s>", methodName.c_str(), Datum(ancestor).asString(true).c_str());
 	}
 
 	return sym;
 }
 
+const Symbol *ScriptContext::findHandler(const Common::String &methodName, AbstractObject *&target) {
+	if (_disposed)
+		return nullptr;
+
+	SymbolHash::iterator it = _functionHandlers.find(methodName);
+	if (it != _functionHandlers.end()) {
+		target = this;
+		return &it->_value;
+	}
+
+	// Builtin methods come before the ancestor, and are not cached
+	if (Object<ScriptContext>::getMethod(methodName).type != VOIDSYM)
+		return nullptr;
+
+	AbstractObject *ancestor = getAncestor();
+	if (ancestor && ancestor->getObjType() == kScriptObj)
+		return static_cast<ScriptContext *>(ancestor)->findHandler(methodName, target);
+
+	return nullptr;
+}
+
 bool ScriptContext::hasProp(const Common::String &propName) {
 	if (_disposed) {
 		error("Property '%s' accessed on disposed object <%s>", propName.c_str(), Datum(this).asString(true).c_str());
@@ -512,11 +551,9 @@ bool ScriptContext::hasProp(const Common::String &propName) {
 	if (_properties.contains(propName)) {
 		return true;
 	}
-	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			return _properties["ancestor"].u.obj->hasProp(propName);
-		}
+	AbstractObject *ancestor = getAncestor();
+	if (ancestor) {
+		return ancestor->hasProp(propName);
 	}
 	return false;
 }
@@ -525,20 +562,35 @@ Datum ScriptContext::getProp(const Common::String &propName) {
 	if (_disposed) {
 		error("Property '%s' accessed on disposed object <%s>", propName.c_str(), Datum(this).asString(true).c_str());
 	}
-	if (_properties.contains(propName)) {
-		return _properties[propName];
+	DatumHash::iterator it = _properties.find(propName);
+	if (it != _properties.end()) {
+		return it->_value;
 	}
-	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), _properties["ancestor"].asString(true).c_str());
-			return _properties["ancestor"].u.obj->getProp(propName);
-		}
+	AbstractObject *ancestor = getAncestor();
+	if (ancestor) {
+		debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), Datum(ancestor).asString(true).c_str());
+		return ancestor->getProp(propName);
 	}
 	_propertyNames.push_back(propName);
+	Lingo::invalidateCaches();
 	return _properties[propName]; // return new property
 }
 
+Datum *ScriptContext::findPropSlot(const Common::String &propName) {
+	if (_disposed)
+		return nullptr;
+
+	DatumHash::iterator it = _properties.find(propName);
+	if (it != _properties.end())
+		return &it->_value;
+
+	AbstractObject *ancestor = getAncestor();
+	if (ancestor && ancestor->getObjType() == kScriptObj)
+		return static_cast<ScriptContext *>(ancestor)->findPropSlot(propName);
+
+	return nullptr;
+}
+
 Common::String ScriptContext::getPropAt(uint32 index) {
 	uint32 target = 1;
 	for (auto &it : _propertyNames) {
@@ -558,25 +610,30 @@ bool ScriptContext::setProp(const Common::String &propName, const Datum &value,
 	if (_disposed) {
 		error("Property '%s' accessed on disposed object <%s>", propName.c_str(), Datum(this).asString(true).c_str());
 	}
-	if (_properties.contains(propName)) {
-		_properties[propName] = value;
+	DatumHash::iterator it = _properties.find(propName);
+	if (it != _properties.end()) {
+		it->_value = value;
+		if (propName.equalsIgnoreCase("ancestor"))
+			Lingo::invalidateCaches();
 		return true;
 	}
 	if (force) {
 		// used by e.g. the script compiler to add properties
 		_propertyNames.push_back(propName);
 		_properties[propName] = value;
+		Lingo::invalidateCaches();
 		return true;
 	} else if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), _properties["ancestor"].asString(true).c_str());
-			return _properties["ancestor"].u.obj->setProp(propName, value, force);
+		AbstractObject *ancestor = getAncestor();
+		if (ancestor) {
+			debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), Datum(ancestor).asString(true).c_str());
+			return ancestor->setProp(propName, value, force);
 		}
 	} else if (_objType == kFactoryObj) {
 		// D3 style anonymous objects/factories, set whatever properties you like
 		_propertyNames.push_back(propName);
 		_properties[propName] = value;
+		Lingo::invalidateCaches();
 		return true;
 	}
 	return false;
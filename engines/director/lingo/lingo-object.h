@@ -160,13 +160,17 @@ public:
 			methodId = methodName;
 		}
 
-		if (_methods && _methods->contains(methodId)) {
-			sym = (*_methods)[methodId];
-			sym.target = this;
-			return sym;
+		if (_methods) {
+			SymbolHash::const_iterator it = _methods->find(methodId);
+			if (it != _methods->end()) {
+				sym = it->_value;
+				sym.target = this;
+				return sym;
+			}
 		}
-		if (g_lingo->_methods.contains(methodId) && (g_lingo->_methods[methodId].targetType & _objType)) {
-			sym = g_lingo->_methods[methodId];
+		SymbolHash::const_iterator it = g_lingo->_methods.find(methodId);
+		if (it != g_lingo->_methods.end() && (it->_value.targetType & _objType)) {
+			sym = it->_value;
 			sym.target = this;
 			return sym;
 		}
@@ -228,6 +232,12 @@ private:
 	Common::Array<Common::String> _propertyNames;
 	bool _onlyInLctxContexts = false;
 
+	/**
+	 * Returns the object which script objects inherit missing properties
+	 * and methods from, or nullptr if there is none.
+	 */
+	AbstractObject *getAncestor();
+
 public:
 	ScriptContext(Common::String name, ScriptType type = kNoneScript, int id = 0);
 	ScriptContext(const ScriptContext &sc);
@@ -239,6 +249,7 @@ public:
 	void setOnlyInLctxContexts() { _onlyInLctxContexts = true; }
 	bool getOnlyInLctxContexts() { return _onlyInLctxContexts; }
 
+	void dispose() override;
 	Common::String asString() override;
 	Symbol getMethod(const Common::String &methodName) override;
 	bool hasProp(const Common::String &propName) override;
@@ -247,6 +258,19 @@ public:
 	uint32 getPropCount() override;
 	bool setProp(const Common::String &propName, const Datum &value, bool force = false) override;
 
+	/**
+	 * Returns the slot holding the property, looking through the ancestors,
+	 * or nullptr if it does not exist yet. The slot stays valid until the
+	 * inline caches are invalidated.
+	 */
+	Datum *findPropSlot(const Common::String &propName);
+	/**
+	 * Returns the handler a method call resolves to, and the object it was
+	 * found on in target. Returns nullptr if the method is not a handler
+	 * of this object or one of its ancestors.
+	 */
+	const Symbol *findHandler(const Common::String &methodName, AbstractObject *&target);
+
 	Symbol define(const Common::String &name, ScriptData *code, Common::Array<Common::String> *argNames, Common::Array<Common::String> *varNames);
 
 	Common::String formatFunctionList(const char *prefix);
@@ -169,6 +169,8 @@ LingoState::~LingoState() {
 
 }
 
+uint32 Lingo::_cacheGeneration = 1;
+
 Lingo::Lingo(DirectorEngine *vm) : _vm(vm) {
 	g_lingo = this;
 
@@ -244,9 +246,12 @@ void Lingo::reloadBuiltIns() {
 	initMethods();
 	initXLibs();
 	reloadOpenXLibs();
+	invalidateCaches();
 }
 
 LingoArchive::~LingoArchive() {
+	Lingo::invalidateCaches();
+
 	// First cleanup the ScriptContexts that are only in LctxContexts.
 	// LctxContexts has a huge overlap with scriptContexts.
 	for (auto &it : lctxContexts){
@@ -332,21 +337,88 @@ Common::String LingoArchive::formatFunctionList(const char *prefix) {
 }
 
 Symbol Lingo::getHandler(const Common::String &name) {
+	const Symbol *handler = findHandler(name);
+	if (handler)
+		return *handler;
+
 	Symbol sym;
+	sym.type = VOIDSYM;
+	sym.name = new Common::String(name);
+	return sym;
+}
 
+const Symbol *Lingo::findHandler(const Common::String &name) {
 	// local functions
-	if (_state->context && _state->context->_functionHandlers.contains(name))
-		return _state->context->_functionHandlers[name];
+	if (_state->context) {
+		SymbolHash::iterator it = _state->context->_functionHandlers.find(name);
+		if (it != _state->context->_functionHandlers.end())
+			return &it->_value;
+	}
 
-	sym = g_director->getCurrentMovie()->getHandler(name);
-	if (sym.type != VOIDSYM)
-		return sym;
+	return g_director->getCurrentMovie()->findHandler(name);
+}
 
-	sym.type = VOIDSYM;
-	sym.name = new Common::String(name);
-	return sym;
+void Lingo::bindCache(InlineCache *cache, const void *owner, const void *scope) {
+	cache->generation = _cacheGeneration;
+	cache->owner = owner;
+	cache->scope = scope;
+	cache->target = nullptr;
+	cache->handler = nullptr;
+	cache->builtinCmd = nullptr;
+	cache->builtinFunc = nullptr;
+	cache->listBuiltin = nullptr;
+	cache->value = nullptr;
 }
 
+Datum *Lingo::findGlobal(InlineCache *cache, const Common::String &name) {
+	if (!isCacheValid(cache, nullptr)) {
+		DatumHash::iterator it = _globalvars.find(name);
+		if (it == _globalvars.end())
+			return nullptr;
+
+		// Globals are only ever erased by clearGlobals, which drops the caches
+		bindCache(cache, nullptr);
+		cache->value = &it->_value;
+	}
+
+	return cache->value;
+}
+
+Datum *Lingo::findProp(InlineCache *cache, AbstractObject *obj, const Common::String &propName) {
+	if (!isCacheValid(cache, obj)) {
+		if (!(obj->getObjType() & (kFactoryObj | kScriptObj)))
+			return nullptr;
+
+		Datum *value = static_cast<ScriptContext *>(obj)->findPropSlot(propName);
+		if (!value)
+			return nullptr;
+
+		bindCache(cache, obj);
+		cache->value = value;
+	}
+
+	return cache->value;
+}
+
+bool Lingo::findMethod(InlineCache *cache, AbstractObject *obj, const Common::String &methodName, Symbol &sym) {
+	if (!isCacheValid(cache, obj)) {
+		if (!(obj->getObjType() & (kFactoryObj | kScriptObj)))
+			return false;
+
+		AbstractObject *target = nullptr;
+		const Symbol *handler = static_cast<ScriptContext *>(obj)->findHandler(methodName, target);
+		if (!handler)
+			return false;
+
+		bindCache(cache, obj);
+		cache->handler = handler;
+		cache->target = target;
+	}
+
+	sym = *cache->handler;
+	sym.target = cache->target;
+	return true;
+}
 
 void LingoArchive::patchCode(const Common::U32String &code, ScriptType type, uint16 id, const char *scriptName, uint32 preprocFlags) {
 	debugC(1, kDebugCompile, "Patching code for type %s(%d) with id %d in '%s%s'\n"
@@ -370,6 +442,7 @@ void LingoArchive::patchCode(const Common::U32String &code, ScriptType type, uin
 		}
 		sc->_functionHandlers.clear();
 		delete sc;
+		Lingo::invalidateCaches();
 	}
 }
 
@@ -404,6 +477,14 @@ void LingoArchive::removeCode(ScriptType type, uint16 id) {
 	if (!ctx)
 		return;
 
+	// The handlers of the script can not be called anymore, so that a
+	// replacement script can define them again
+	for (auto &it : functionHandlers) {
+		if (it._value.ctx == ctx)
+			functionHandlers.erase(it._key);
+	}
+	Lingo::invalidateCaches();
+
 	ctx->decRefCount();
 	scriptContexts[type].erase(id);
 }
@@ -559,11 +640,14 @@ Common::String Lingo::decodeInstruction(ScriptData *sd, uint pc, uint *newPc) {
 					res += Common::String::format(" %s", field2str(v));
 					break;
 				}
+			case 'C':
+				pc += calcCodeAlignment(sizeof(InlineCache));
+				break;
 			default:
 				warning("Lingo::decodeInstruction(): Unknown parameter type: %c", pars[-1]);
 			}
 
-			if (*pars)
+			if (*pars && *pars != 'C')
 				res += ',';
 		}
 	} else {
@@ -1619,9 +1703,10 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 	switch (var.type) {
 	case VARREF:
 		{
-			Common::String name = *var.u.s;
-			if (_state->localVars && _state->localVars->contains(name)) {
-				(*_state->localVars)[name] = value;
+			const Common::String &name = *var.u.s;
+			DatumHash::iterator it;
+			if (_state->localVars && (it = _state->localVars->find(name)) != _state->localVars->end()) {
+				it->_value = value;
 				g_debugger->varWriteHook(name);
 				return;
 			}
@@ -1643,9 +1728,10 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 		break;
 	case LOCALREF:
 		{
-			Common::String name = *var.u.s;
-			if (_state->localVars && _state->localVars->contains(name)) {
-				(*_state->localVars)[name] = value;
+			const Common::String &name = *var.u.s;
+			DatumHash::iterator it;
+			if (_state->localVars && (it = _state->localVars->find(name)) != _state->localVars->end()) {
+				it->_value = value;
 				g_debugger->varWriteHook(name);
 			} else {
 				warning("varAssign: local variable %s not defined", name.c_str());
@@ -1654,7 +1740,7 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 		break;
 	case PROPREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				_state->me.u.obj->setProp(name, value);
 				g_debugger->varWriteHook(name);
@@ -1735,18 +1821,18 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 	switch (var.type) {
 	case VARREF:
 		{
-			Datum d;
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
 
-			if (_state->localVars && _state->localVars->contains(name)) {
-				return (*_state->localVars)[name];
+			DatumHash::const_iterator it;
+			if (_state->localVars && (it = _state->localVars->find(name)) != _state->localVars->end()) {
+				return it->_value;
 			}
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				return _state->me.u.obj->getProp(name);
 			}
-			if (_globalvars.contains(name)) {
-				return _globalvars[name];
+			if ((it = _globalvars.find(name)) != _globalvars.end()) {
+				return it->_value;
 			}
 
 			if (!silent)
@@ -1756,10 +1842,11 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 		break;
 	case GLOBALREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
-			if (_globalvars.contains(name)) {
-				return _globalvars[name];
+			DatumHash::const_iterator it = _globalvars.find(name);
+			if (it != _globalvars.end()) {
+				return it->_value;
 			}
 			debugC(1, kDebugLingoExec, "varFetch: global variable %s not defined", name.c_str());
 			return result;
@@ -1767,10 +1854,11 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 		break;
 	case LOCALREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
-			if (_state->localVars && _state->localVars->contains(name)) {
-				return (*_state->localVars)[name];
+			DatumHash::const_iterator it;
+			if (_state->localVars && (it = _state->localVars->find(name)) != _state->localVars->end()) {
+				return it->_value;
 			}
 			debugC(1, kDebugLingoExec, "varFetch: local variable %s not defined", name.c_str());
 			return result;
@@ -1778,7 +1866,7 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 		break;
 	case PROPREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			g_debugger->varReadHook(name);
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				return _state->me.u.obj->getProp(name);
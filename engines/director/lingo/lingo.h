@@ -259,6 +259,25 @@ struct CFrame {	/* proc/func call stack frame */
 	int				paramCount;			/* original number of arguments submitted */
 };
 
+/*
+ * Result of a name lookup, kept in the code of a call site or variable or
+ * property access. The compiler reserves one for each such site when the
+ * script is loaded, and the first execution binds the name to the table
+ * entry it resolves to. An entry is valid while Lingo::_cacheGeneration is
+ * unchanged and the site runs for the same owner and scope.
+ */
+struct InlineCache {
+	uint32			generation;			/* Lingo::_cacheGeneration when bound, 0 if empty */
+	const void		*owner;				/* context or object the name was resolved for */
+	const void		*scope;				/* movie the name was resolved in */
+	AbstractObject	*target;			/* object a method was found on */
+	const Symbol	*handler;			/* handler or method, nullptr if there is none */
+	const Symbol	*builtinCmd;		/* builtin command, nullptr if there is none */
+	const Symbol	*builtinFunc;		/* builtin function, nullptr if there is none */
+	const Symbol	*listBuiltin;		/* list builtin, nullptr if there is none */
+	Datum			*value;				/* global variable or property */
+};
+
 struct LingoEvent {
 	LEvent event;
 	int eventId;
@@ -400,6 +419,7 @@ private:
 public:
 	ScriptType event2script(LEvent ev);
 	Symbol getHandler(const Common::String &name);
+	const Symbol *findHandler(const Common::String &name);
 
 	void processEvents(Common::Queue<LingoEvent> &queue, bool isInputEvent);
 
@@ -431,6 +451,23 @@ public:
 	double getFloat(uint pc) { return *(double *)(&((*_state->script)[_state->pc])); }
 	char *readString() { char *s = getString(_state->pc); _state->pc += calcStringAlignment(s); return s; }
 	char *getString(uint pc) { return (char *)(&((*_state->script)[_state->pc])); }
+	InlineCache *readInlineCache() { InlineCache *c = (InlineCache *)(&((*_state->script)[_state->pc])); _state->pc += calcCodeAlignment(sizeof(InlineCache)); return c; }
+
+	// Inline caches
+	/**
+	 * Drop all inline cache entries. This has to be called whenever a
+	 * handler table, the global variables or the properties or ancestor of
+	 * an object change in a way that could change what a name resolves to,
+	 * or free the entries that the caches point to.
+	 */
+	static void invalidateCaches() { if (++_cacheGeneration == 0) _cacheGeneration = 1; }
+	bool isCacheValid(const InlineCache *cache, const void *owner, const void *scope = nullptr) const {
+		return cache->generation == _cacheGeneration && cache->owner == owner && cache->scope == scope;
+	}
+	void bindCache(InlineCache *cache, const void *owner, const void *scope = nullptr);
+	Datum *findGlobal(InlineCache *cache, const Common::String &name);
+	Datum *findProp(InlineCache *cache, AbstractObject *obj, const Common::String &propName);
+	bool findMethod(InlineCache *cache, AbstractObject *obj, const Common::String &methodName, Symbol &sym);
 
 	Datum getVoid();
 	void pushVoid();
@@ -538,6 +575,8 @@ public:
 
 	DatumHash _globalvars;
 
+	static uint32 _cacheGeneration;
+
 	FuncHash _functions;
 
 	Common::HashMap<int, LingoV4Bytecode *> _lingoV4;
@@ -112,6 +112,7 @@ Movie::~Movie() {
 	delete _cast;
 	delete _sharedCast;
 	delete _score;
+	Lingo::invalidateCaches();
 }
 
 void Movie::setArchive(Archive *archive) {
@@ -181,6 +182,7 @@ void Movie::loadCastLibMapping(Common::SeekableReadStreamEndian &stream) {
 		} else {
 			cast = new Cast(this, libId, false, isExternal);
 			_casts.setVal(libId, cast);
+			Lingo::invalidateCaches();
 		}
 		_castNames[name] = libId;
 		cast->setArchive(castArchive);
@@ -376,6 +378,7 @@ void Movie::clearSharedCast() {
 
 	delete _sharedCast;
 	_sharedCast = nullptr;
+	Lingo::invalidateCaches();
 }
 
 void Movie::loadSharedCastsFrom(Common::Path &filename) {
@@ -397,6 +400,7 @@ void Movie::loadSharedCastsFrom(Common::Path &filename) {
 	_sharedCast = new Cast(this, DEFAULT_CAST_LIB, true, false);
 	_sharedCast->setArchive(sharedCast);
 	_sharedCast->loadArchive();
+	Lingo::invalidateCaches();
 }
 
 Archive *Movie::loadExternalCastFrom(Common::Path &filename) {
@@ -617,15 +621,29 @@ ScriptContext *Movie::getScriptContext(ScriptType type, CastMemberID id) {
 }
 
 Symbol Movie::getHandler(const Common::String &name) {
+	const Symbol *sym = findHandler(name);
+	if (sym)
+		return *sym;
+
+	return Symbol();
+}
+
+const Symbol *Movie::findHandler(const Common::String &name) {
 	for (auto &it : _casts) {
-		if (it._value->_lingoArchive->functionHandlers.contains(name))
-			return it._value->_lingoArchive->functionHandlers[name];
+		const SymbolHash &handlers = it._value->_lingoArchive->functionHandlers;
+		SymbolHash::const_iterator handler = handlers.find(name);
+		if (handler != handlers.end())
+			return &handler->_value;
 	}
 
-	if (_sharedCast && _sharedCast->_lingoArchive->functionHandlers.contains(name))
-		return _sharedCast->_lingoArchive->functionHandlers[name];
+	if (_sharedCast) {
+		const SymbolHash &handlers = _sharedCast->_lingoArchive->functionHandlers;
+		SymbolHash::const_iterator handler = handlers.find(name);
+		if (handler != handlers.end())
+			return &handler->_value;
+	}
 
-	return Symbol();
+	return nullptr;
 }
 
 Common::String InfoEntry::readString(bool pascal) {
@@ -125,6 +125,7 @@ public:
 	LingoArchive *getSharedLingoArch();
 	ScriptContext *getScriptContext(ScriptType type, CastMemberID id);
 	Symbol getHandler(const Common::String &name);
+	const Symbol *findHandler(const Common::String &name);
 
 	// events.cpp
 	bool processEvent(Common::Event &event);
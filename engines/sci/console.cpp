@@ -54,6 +54,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -150,6 +151,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
+	registerCmd("frame_stats",        WRAP_METHOD(Console, cmdFrameStats));
 	// Segments
 	registerCmd("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	registerCmd("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -386,6 +389,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
+	debugPrintf(" cel_cache - Shows the hit rates of the cel caches (SCI2+)\n");
+	debugPrintf(" frame_stats - Shows the pixel counts of the last rendered frame (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Segments:\n");
 	debugPrintf(" segment_table / segtable - Lists all segments\n");
@@ -2291,6 +2296,42 @@ bool Console::cmdSavedBits(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (_engine->_gfxFrameout) {
+		const CelCacheStats stats = CelObj::getCacheStats();
+		const uint32 lookups = stats.hits + stats.misses;
+		const uint32 draws = stats.pixelHits + stats.pixelMisses;
+		debugPrintf("Cel objects: %u hits, %u misses (%u%% hit rate)\n",
+		            stats.hits, stats.misses, lookups ? stats.hits * 100 / lookups : 0);
+		debugPrintf("Cel pixels: %u hits, %u misses (%u%% hit rate), %u evictions, %u bytes in use\n",
+		            stats.pixelHits, stats.pixelMisses, draws ? stats.pixelHits * 100 / draws : 0,
+		            stats.pixelEvictions, stats.pixelBytes);
+	} else {
+		debugPrintf("This SCI version does not have cel caches\n");
+	}
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
+bool Console::cmdFrameStats(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (_engine->_gfxFrameout) {
+		const FrameOutStats &stats = _engine->_gfxFrameout->getLastFrameStats();
+		debugPrintf("Erased: %u pixels in %u rects (%u rects joined)\n", stats.erasedPixels, stats.eraseRects, stats.joinedEraseRects);
+		debugPrintf("Drawn: %u pixels in %u rects\n", stats.drawnPixels, stats.drawRects);
+		debugPrintf("Shown: %u pixels in %u rects\n", stats.shownPixels, stats.showRects);
+	} else {
+		debugPrintf("This SCI version does not have frame statistics\n");
+	}
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdShowSavedBits(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("Display saved bits.\n");
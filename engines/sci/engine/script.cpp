@@ -74,6 +74,29 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
+
+	_decodedIndex.clear();
+	_decodedInstructions.clear();
+}
+
+const DecodedInstruction &Script::getDecodedInstruction(uint32 offset) {
+	if (_decodedIndex.empty())
+		_decodedIndex.resize(getBufSize());
+
+	uint16 &index = _decodedIndex[offset];
+	if (index)
+		return _decodedInstructions[index - 1];
+
+	DecodedInstruction *instruction = &_uncachedInstruction;
+	// The index is 16-bit, further instructions are decoded every time
+	if (_decodedInstructions.size() < 0xFFFF) {
+		_decodedInstructions.push_back(DecodedInstruction());
+		index = _decodedInstructions.size();
+		instruction = &_decodedInstructions.back();
+	}
+
+	instruction->size = readPMachineInstruction(getBuf(offset), instruction->extOpcode, instruction->opparams);
+	return *instruction;
 }
 
 enum {
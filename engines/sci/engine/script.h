@@ -68,6 +68,16 @@ struct offsetLookupArrayEntry {
 
 typedef Common::Array<offsetLookupArrayEntry> offsetLookupArrayType;
 
+/**
+ * A P-Machine instruction with its operands already read, as returned by
+ * Script::getDecodedInstruction().
+ */
+struct DecodedInstruction {
+	int16 opparams[4]; ///< Operands, as filled in by readPMachineInstruction()
+	uint16 size;       ///< Size of the instruction in bytes
+	byte extOpcode;    ///< Opcode, including the operand size bit
+};
+
 class Script : public SegmentObj {
 private:
 	int _nr; /**< Script number */
@@ -101,6 +111,17 @@ private:
 	uint16 _offsetLookupStringCount;
 	uint16 _offsetLookupSaidCount;
 
+	/**
+	 * Instructions which have been executed so far. Script code does not
+	 * change once the script has been loaded, so each instruction only has
+	 * to be decoded once. _decodedIndex holds, for each byte of the buffer,
+	 * 0 if no instruction starting there has been decoded yet, otherwise
+	 * the index into _decodedInstructions plus one.
+	 */
+	Common::Array<uint16> _decodedIndex;
+	Common::Array<DecodedInstruction> _decodedInstructions;
+	DecodedInstruction _uncachedInstruction;
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -126,6 +147,12 @@ public:
 	ObjMap &getObjectMap() { return _objects; }
 	const ObjMap &getObjectMap() const { return _objects; }
 
+	/**
+	 * Returns the instruction starting at the given offset of the buffer,
+	 * decoding it on first use. The result is only valid until the next call.
+	 */
+	const DecodedInstruction &getDecodedInstruction(uint32 offset);
+
 	// speed optimization: inline due to frequent calling
 	bool offsetIsObject(uint32 offset) const {
 		return _buf->getUint16SEAt(offset + SCRIPT_OBJECT_MAGIC_OFFSET) == SCRIPT_OBJECT_MAGIC_NUMBER;
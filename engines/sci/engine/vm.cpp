@@ -601,16 +601,19 @@ void run_vm(EngineState *s) {
 			s->variables[VAR_PARAM] = s->xs->variables_argp;
 		}
 
-		g_sci->checkAddressBreakpoint(s->xs->addr.pc);
-
-		// Debug if this has been requested:
-		// TODO: re-implement sci_debug_flags
-		if (g_sci->_debugState.debugging /* sci_debug_flags*/) {
-			g_sci->scriptDebug();
-			g_sci->_debugState.breakpointWasHit = false;
-		}
+		// Breakpoints and the debugger are only looked at while in use
 		Console *con = g_sci->getSciDebugger();
-		con->onFrame();
+		if (g_sci->_debugState._activeBreakpointTypes || g_sci->_debugState.debugging || con->isAttached()) {
+			g_sci->checkAddressBreakpoint(s->xs->addr.pc);
+
+			// Debug if this has been requested:
+			// TODO: re-implement sci_debug_flags
+			if (g_sci->_debugState.debugging /* sci_debug_flags*/) {
+				g_sci->scriptDebug();
+				g_sci->_debugState.breakpointWasHit = false;
+			}
+			con->onFrame();
+		}
 
 		if (s->xs->sp < s->xs->fp)
 			error("run_vm(): stack underflow, sp: %04x:%04x, fp: %04x:%04x",
@@ -620,9 +623,13 @@ void run_vm(EngineState *s) {
 			error("run_vm(): program counter gone astray, addr: %d, code buffer size: %d",
 			s->xs->addr.pc.getOffset(), scr->getBufSize());
 
-		// Get opcode
-		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		// Get opcode. The operands are copied, as the cached instruction
+		// may go away while it executes, e.g. when a kernel call runs
+		// another script.
+		const DecodedInstruction &instruction = scr->getDecodedInstruction(s->xs->addr.pc.getOffset());
+		memcpy(opparams, instruction.opparams, sizeof(opparams));
+		const byte extOpcode = instruction.extOpcode;
+		s->xs->addr.pc.incOffset(instruction.size);
 		const byte opcode = extOpcode >> 1;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
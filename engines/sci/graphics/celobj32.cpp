@@ -81,6 +81,113 @@ const CelScalerTable &CelScaler::getScalerTable(const Ratio &scaleX, const Ratio
 	return _scaleTables[_activeIndex];
 }
 
+#pragma mark -
+#pragma mark CelPixelCache
+
+/**
+ * Keeps the pixels of view and pic cels that were decompressed or smoothly
+ * rescaled for a scaled draw, so that the next draw of the same cel at the
+ * same ratio can read them back instead of producing them again. Mirroring is
+ * applied by the scaler lookup tables when reading, so mirrored and unmirrored
+ * draws share the same entry.
+ */
+class CelPixelCache {
+public:
+	struct Key {
+		CelInfo32 info;
+		Ratio scaleX, scaleY;
+		bool smooth; ///< Rescaled by LarryScale rather than just decompressed
+
+		bool operator==(const Key &other) const {
+			return info == other.info && scaleX == other.scaleX && scaleY == other.scaleY && smooth == other.smooth;
+		}
+	};
+
+	enum {
+		kBudget = 8 * 1024 * 1024 ///< Bytes of pixel data kept at most
+	};
+
+	CelPixelCache() : _usedBytes(0), _tick(0), _hits(0), _misses(0), _evictions(0) {}
+
+	/**
+	 * Returns whether pixels of the given cel can be kept. Only view and pic
+	 * cels come from immutable resources; bitmaps may be changed by scripts at
+	 * any time.
+	 */
+	static bool isCacheable(const CelObj &celObj) {
+		return celObj._info.type == kCelTypeView || celObj._info.type == kCelTypePic;
+	}
+
+	Common::SharedPtr<Buffer> find(const Key &key) {
+		EntryMap::iterator it = _entries.find(key);
+		if (it == _entries.end()) {
+			++_misses;
+			return Common::SharedPtr<Buffer>();
+		}
+
+		++_hits;
+		it->_value.lastUse = ++_tick;
+		return it->_value.buffer;
+	}
+
+	void add(const Key &key, const Common::SharedPtr<Buffer> &buffer) {
+		const uint32 size = buffer->w * buffer->h;
+		if (size > kBudget / 4) {
+			return;
+		}
+
+		while (_usedBytes + size > kBudget && !_entries.empty()) {
+			EntryMap::iterator oldest = _entries.begin();
+			for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+				if (it->_value.lastUse < oldest->_value.lastUse) {
+					oldest = it;
+				}
+			}
+
+			_usedBytes -= oldest->_value.size;
+			_entries.erase(oldest);
+			++_evictions;
+		}
+
+		Entry &entry = _entries[key];
+		entry.buffer = buffer;
+		entry.size = size;
+		entry.lastUse = ++_tick;
+		_usedBytes += size;
+	}
+
+	void fillStats(CelCacheStats &stats) const {
+		stats.pixelHits = _hits;
+		stats.pixelMisses = _misses;
+		stats.pixelEvictions = _evictions;
+		stats.pixelBytes = _usedBytes;
+	}
+
+private:
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			uint hash = CelInfo32Hash()(key.info);
+			hash = hash * 31 + (uint)(key.scaleX.getNumerator() << 16 ^ key.scaleX.getDenominator());
+			hash = hash * 31 + (uint)(key.scaleY.getNumerator() << 16 ^ key.scaleY.getDenominator());
+			return hash * 31 + key.smooth;
+		}
+	};
+
+	struct Entry {
+		Common::SharedPtr<Buffer> buffer;
+		uint32 size;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+	EntryMap _entries;
+	uint32 _usedBytes;
+	uint32 _tick;
+	uint32 _hits, _misses, _evictions;
+};
+
+CelPixelCache *CelObj::_pixelCache = nullptr;
+
 #pragma mark -
 #pragma mark CelObj
 bool CelObj::_drawBlackLines = false;
@@ -89,8 +196,10 @@ void CelObj::init() {
 	CelObj::deinit();
 	_drawBlackLines = false;
 	_nextCacheId = 1;
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
 	_scaler = new CelScaler();
 	_cache = new CelCache(100);
+	_pixelCache = new CelPixelCache();
 }
 
 void CelObj::deinit() {
@@ -98,6 +207,16 @@ void CelObj::deinit() {
 	_scaler = nullptr;
 	delete _cache;
 	_cache = nullptr;
+	delete _pixelCache;
+	_pixelCache = nullptr;
+}
+
+CelCacheStats CelObj::getCacheStats() {
+	CelCacheStats stats = _cacheStats;
+	if (_pixelCache) {
+		_pixelCache->fillStats(stats);
+	}
+	return stats;
 }
 
 #pragma mark -
@@ -204,6 +323,10 @@ struct SCALER_Scale {
 
 		const CelScalerTable &table = CelObj::_scaler->getScalerTable(scaleX, scaleY);
 
+		CelPixelCache::Key cacheKey;
+		cacheKey.info = celObj._info;
+		const bool useCache = CelPixelCache::isCacheable(celObj);
+
 		const bool useLarryScale = Common::checkGameGUIOption(GAMEOPTION_LARRYSCALE, ConfMan.get("guioptions")) && ConfMan.getBool("enable_larryscale");
 		if (useLarryScale) {
 			// LarryScale is an alternative, high-quality cel scaler implemented
@@ -234,14 +357,28 @@ struct SCALER_Scale {
 				scaledPosition.y,
 				scaledPosition.x + (celObj._width * scaleX).toInt(),
 				scaledPosition.y + (celObj._height * scaleY).toInt());
-			_sourceBuffer = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
-			_sourceBuffer->create(
-				scaledImageRect.width(), scaledImageRect.height(),
-				Graphics::PixelFormat::createFormatCLUT8());
-			Copier copier(_reader, *_sourceBuffer);
-			Graphics::larryScale(
-				celObj._width, celObj._height, celObj._skipColor, copier,
-				scaledImageRect.width(), scaledImageRect.height(), copier);
+			// Smooth upscaling is by far the most expensive part of drawing,
+			// so the result is kept for later draws at the same ratio
+			cacheKey.scaleX = scaleX;
+			cacheKey.scaleY = scaleY;
+			cacheKey.smooth = true;
+			if (useCache) {
+				_sourceBuffer = CelObj::_pixelCache->find(cacheKey);
+			}
+
+			if (!_sourceBuffer) {
+				_sourceBuffer = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
+				_sourceBuffer->create(
+					scaledImageRect.width(), scaledImageRect.height(),
+					Graphics::PixelFormat::createFormatCLUT8());
+				Copier copier(_reader, *_sourceBuffer);
+				Graphics::larryScale(
+					celObj._width, celObj._height, celObj._skipColor, copier,
+					scaledImageRect.width(), scaledImageRect.height(), copier);
+				if (useCache) {
+					CelObj::_pixelCache->add(cacheKey, _sourceBuffer);
+				}
+			}
 
 			// Set _valuesX and _valuesY to reference the scaled image without additional scaling
 			for (int16 x = targetRect.left; x < targetRect.right; ++x) {
@@ -255,6 +392,23 @@ struct SCALER_Scale {
 				_valuesY[y] = CLIP<int16>(unsafeValue, 0, scaledImageRect.height() - 1);
 			}
 		} else {
+			// Scaled reads jump between source rows, so compressed cels are
+			// decompressed once and then read from the cache
+			if (READER::kCompressed && useCache) {
+				cacheKey.scaleX = Ratio(1, 1);
+				cacheKey.scaleY = Ratio(1, 1);
+				cacheKey.smooth = false;
+				_sourceBuffer = CelObj::_pixelCache->find(cacheKey);
+				if (!_sourceBuffer) {
+					_sourceBuffer = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
+					_sourceBuffer->create(celObj._width, celObj._height, Graphics::PixelFormat::createFormatCLUT8());
+					for (int16 y = 0; y < celObj._height; ++y) {
+						memcpy(_sourceBuffer->getBasePtr(0, y), _reader.getRow(y), celObj._width);
+					}
+					CelObj::_pixelCache->add(cacheKey, _sourceBuffer);
+				}
+			}
+
 			const bool useGlobalScaling = g_sci->_gfxFrameout->getScriptWidth() == kLowResX;
 			if (useGlobalScaling) {
 				const int16 unscaledX = (scaledPosition.x / scaleX).toInt();
@@ -323,6 +477,8 @@ private:
 	const int16 _sourceWidth;
 
 public:
+	static const bool kCompressed = false;
+
 	READER_Uncompressed(const CelObj &celObj, const int16) :
 #ifndef NDEBUG
 	_sourceHeight(celObj._height),
@@ -361,6 +517,8 @@ private:
 	const int16 _maxWidth;
 
 public:
+	static const bool kCompressed = true;
+
 	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
 	_resource(celObj.getResPointer()),
 	_y(-1),
@@ -689,21 +847,32 @@ void CelObj::submitPalette() const {
 int CelObj::_nextCacheId = 1;
 CelCache *CelObj::_cache = nullptr;
 
+CelCacheStats CelObj::_cacheStats;
+
 int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
 	*nextInsertIndex = -1;
+
+	Common::HashMap<CelInfo32, int, CelInfo32Hash>::const_iterator it = _cache->index.find(celInfo);
+	if (it != _cache->index.end()) {
+		++_cacheStats.hits;
+		_cache->slots[it->_value].id = ++_nextCacheId;
+		return it->_value;
+	}
+
+	++_cacheStats.misses;
+
+	// Only a miss needs to look for the slot to replace, and a miss has to
+	// load the cel from its resource anyway
 	int oldestId = _nextCacheId + 1;
 	int oldestIndex = 0;
 
-	for (int i = 0, len = _cache->size(); i < len; ++i) {
-		CelCacheEntry &entry = (*_cache)[i];
+	for (int i = 0, len = _cache->slots.size(); i < len; ++i) {
+		const CelCacheEntry &entry = _cache->slots[i];
 
 		if (entry.celObj == nullptr) {
 			if (*nextInsertIndex == -1) {
 				*nextInsertIndex = i;
 			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
 		} else if (oldestId > entry.id) {
 			oldestId = entry.id;
 			oldestIndex = i;
@@ -722,9 +891,13 @@ void CelObj::putCopyInCache(const int cacheIndex) const {
 		error("Invalid cache index");
 	}
 
-	CelCacheEntry &entry = (*_cache)[cacheIndex];
+	CelCacheEntry &entry = _cache->slots[cacheIndex];
+	if (entry.celObj) {
+		_cache->index.erase(entry.celObj->_info);
+	}
 	entry.celObj.reset(duplicate());
 	entry.id = ++_nextCacheId;
+	_cache->index[_info] = cacheIndex;
 }
 
 #pragma mark -
@@ -974,7 +1147,7 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 	int cacheInsertIndex;
 	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
 	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
+		CelCacheEntry &entry = _cache->slots[cacheIndex];
 		const CelObjView *const cachedCelObj = dynamic_cast<CelObjView *>(entry.celObj.get());
 		if (cachedCelObj == nullptr) {
 			error("Expected a CelObjView in cache slot %d", cacheIndex);
@@ -1182,7 +1355,7 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 	int cacheInsertIndex;
 	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
 	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
+		CelCacheEntry &entry = _cache->slots[cacheIndex];
 		const CelObjPic *const cachedCelObj = dynamic_cast<CelObjPic *>(entry.celObj.get());
 		if (cachedCelObj == nullptr) {
 			error("Expected a CelObjPic in cache slot %d", cacheIndex);
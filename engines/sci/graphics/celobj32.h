@@ -22,6 +22,7 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -105,7 +106,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -115,7 +116,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -146,7 +147,50 @@ struct CelCacheEntry {
 	CelCacheEntry() : id(0) {}
 };
 
-typedef Common::Array<CelCacheEntry> CelCache;
+struct CelInfo32Hash {
+	uint operator()(const CelInfo32 &info) const {
+		uint hash = info.type;
+		hash = hash * 31 + info.resourceId;
+		hash = hash * 31 + (uint16)info.loopNo;
+		hash = hash * 31 + (uint16)info.celNo;
+		return hash * 31 + ((info.bitmap.getSegment() << 16) ^ info.bitmap.getOffset());
+	}
+};
+
+/**
+ * The cel object cache. The slots are replaced in least recently used order,
+ * and `index` maps the CelInfo32 of every occupied slot to its position so
+ * that lookups do not need to compare against every slot.
+ */
+struct CelCache {
+	Common::Array<CelCacheEntry> slots;
+	Common::HashMap<CelInfo32, int, CelInfo32Hash> index;
+
+	CelCache(uint size) : slots(size) {}
+};
+
+/**
+ * Usage counters of the cel caches, shown by the `cel_cache` debugger command.
+ */
+struct CelCacheStats {
+	/**
+	 * Lookups of view and pic cels that were found in the cel object cache.
+	 */
+	uint32 hits;
+	uint32 misses;
+
+	/**
+	 * Draws that reused decompressed or rescaled pixels from the pixel cache.
+	 */
+	uint32 pixelHits;
+	uint32 pixelMisses;
+	uint32 pixelEvictions;
+
+	/**
+	 * The number of bytes of pixel data currently held by the pixel cache.
+	 */
+	uint32 pixelBytes;
+};
 
 #pragma mark -
 #pragma mark CelScaler
@@ -235,6 +279,7 @@ public:
 #pragma mark CelObj
 
 class ScreenItem;
+class CelPixelCache;
 /**
  * A cel object is the lowest-level rendering primitive in the SCI engine and
  * draws itself directly to a target pixel buffer.
@@ -262,6 +307,12 @@ protected:
 public:
 	static CelScaler *_scaler;
 
+	/**
+	 * A byte-budgeted cache of cel pixels which were decompressed or rescaled
+	 * by a previous draw.
+	 */
+	static CelPixelCache *_pixelCache;
+
 	/**
 	 * The basic identifying information for this cel. This information
 	 * effectively acts as a composite key for a cel object, and any cel object
@@ -348,6 +399,11 @@ public:
 	 */
 	static void deinit();
 
+	/**
+	 * Returns the usage counters of the cel object and pixel caches.
+	 */
+	static CelCacheStats getCacheStats();
+
 	virtual ~CelObj() {};
 
 	/**
@@ -462,9 +518,14 @@ protected:
 	 */
 	static CelCache *_cache;
 
+	/**
+	 * Hit and miss counters of the cel object cache.
+	 */
+	static CelCacheStats _cacheStats;
+
 	/**
 	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
-	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
+	 * not found, -1 is returned and `nextInsertIndex` will receive the index of
 	 * the oldest item in the cache, which can be used to replace the oldest
 	 * item with a newer item.
 	 */
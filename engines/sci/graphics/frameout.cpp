@@ -72,6 +72,9 @@ GfxFrameout::GfxFrameout(SegManager *segMan, GfxPalette32 *palette, GfxTransitio
 	_palMorphIsOn(false),
 	_lastScreenUpdateTick(0) {
 
+	memset(&_frameStats, 0, sizeof(_frameStats));
+	memset(&_lastFrameStats, 0, sizeof(_lastFrameStats));
+
 	if (g_sci->getGameId() == GID_PHANTASMAGORIA) {
 		_currentBuffer.create(630, 450, Graphics::PixelFormat::createFormatCLUT8());
 	} else if (_isHiRes) {
@@ -752,6 +755,56 @@ int splitRectsForRender(Common::Rect &middleRect, const Common::Rect &showRect,
 	return splitCount;
 }
 
+/**
+ * Joins rects in `rects` that contain one another, or that span the same rows
+ * or columns and touch, into single rects. Unlike the overdraw threshold used
+ * for the show list, this never grows the covered area, so it does not change
+ * which pixels get drawn.
+ *
+ * @returns the number of rects that were removed from the list.
+ */
+int joinAdjacentRects(RectList &rects) {
+	int removedCount = 0;
+	bool didJoin;
+	do {
+		didJoin = false;
+		for (RectList::size_type i = 0; i < rects.size(); ++i) {
+			Common::Rect *const r1 = rects[i];
+			if (r1 == nullptr || r1->isEmpty()) {
+				continue;
+			}
+
+			for (RectList::size_type j = i + 1; j < rects.size(); ++j) {
+				const Common::Rect *const r2 = rects[j];
+				if (r2 == nullptr) {
+					continue;
+				}
+
+				const bool sameRows = r1->top == r2->top && r1->bottom == r2->bottom;
+				const bool sameColumns = r1->left == r2->left && r1->right == r2->right;
+				if (r2->isEmpty() || r1->contains(*r2) ||
+					(sameRows && r1->right >= r2->left && r2->right >= r1->left) ||
+					(sameColumns && r1->bottom >= r2->top && r2->bottom >= r1->top)) {
+					if (!r2->isEmpty()) {
+						r1->extend(*r2);
+					}
+				} else if (r2->contains(*r1)) {
+					*r1 = *r2;
+				} else {
+					continue;
+				}
+
+				rects.erase_at(j);
+				++removedCount;
+				didJoin = true;
+			}
+		}
+	} while (didJoin);
+
+	rects.pack();
+	return removedCount;
+}
+
 // The third rectangle parameter is only ever passed by VMD code
 void GfxFrameout::calcLists(ScreenItemListList &drawLists, EraseListList &eraseLists, const Common::Rect &eraseRect) {
 	RectList eraseList;
@@ -994,16 +1047,21 @@ void GfxFrameout::calcLists(ScreenItemListList &drawLists, EraseListList &eraseL
 	}
 }
 
-void GfxFrameout::drawEraseList(const RectList &eraseList, const Plane &plane) {
+void GfxFrameout::drawEraseList(RectList &eraseList, const Plane &plane) {
 	if (plane._type != kPlaneTypeColored) {
 		return;
 	}
 
+	_frameStats.joinedEraseRects += joinAdjacentRects(eraseList);
+
 	const RectList::size_type eraseListSize = eraseList.size();
 	for (RectList::size_type i = 0; i < eraseListSize; ++i) {
-		mergeToShowList(*eraseList[i], _showList, _overdrawThreshold);
-		_currentBuffer.fillRect(*eraseList[i], plane._back);
+		const Common::Rect &rect = *eraseList[i];
+		mergeToShowList(rect, _showList, _overdrawThreshold);
+		_currentBuffer.fillRect(rect, plane._back);
+		_frameStats.erasedPixels += rect.width() * rect.height();
 	}
+	_frameStats.eraseRects += eraseListSize;
 }
 
 void GfxFrameout::drawScreenItemList(const DrawList &screenItemList) {
@@ -1011,10 +1069,12 @@ void GfxFrameout::drawScreenItemList(const DrawList &screenItemList) {
 	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
 		const DrawItem &drawItem = *screenItemList[i];
 		mergeToShowList(drawItem.rect, _showList, _overdrawThreshold);
+		_frameStats.drawnPixels += drawItem.rect.width() * drawItem.rect.height();
 		const ScreenItem &screenItem = *drawItem.screenItem;
 		CelObj &celObj = *screenItem._celObj;
 		celObj.draw(_currentBuffer, screenItem, drawItem.rect, screenItem._mirrorX ^ celObj._mirrorX);
 	}
+	_frameStats.drawRects += drawListSize;
 }
 
 void GfxFrameout::mergeToShowList(const Common::Rect &drawRect, RectList &showList, const int overdrawThreshold) {
@@ -1077,6 +1137,7 @@ void GfxFrameout::mergeToShowList(const Common::Rect &drawRect, RectList &showLi
 
 void GfxFrameout::showBits() {
 	if (!_showList.size()) {
+		finishFrameStats();
 		updateScreen();
 		return;
 	}
@@ -1126,14 +1187,28 @@ void GfxFrameout::showBits() {
 #endif
 			g_system->copyRectToScreen(sourceBuffer, _currentBuffer.w, rounded.left, rounded.top, rounded.width(), rounded.height());
 		}
+
+		_frameStats.shownPixels += rounded.width() * rounded.height();
+		++_frameStats.showRects;
 	}
 
 	_cursor->donePainting();
 
 	_showList.clear();
+	finishFrameStats();
 	updateScreen();
 }
 
+void GfxFrameout::finishFrameStats() {
+	debugC(2, kDebugLevelGraphics, "Frame: erased %u px in %u rects (%u joined), drew %u px in %u rects, showed %u px in %u rects",
+	       _frameStats.erasedPixels, _frameStats.eraseRects, _frameStats.joinedEraseRects,
+	       _frameStats.drawnPixels, _frameStats.drawRects,
+	       _frameStats.shownPixels, _frameStats.showRects);
+
+	_lastFrameStats = _frameStats;
+	memset(&_frameStats, 0, sizeof(_frameStats));
+}
+
 void GfxFrameout::alterVmap(const Palette &palette1, const Palette &palette2, const int8 style, const int8 *const styleRanges) {
 	uint8 clut[256];
 
@@ -35,6 +35,32 @@ class GfxCursor32;
 class GfxTransitions32;
 struct PlaneShowStyle;
 
+/**
+ * Pixel counts of a frame, from the first rect drawn after the previous
+ * `showBits` up to and including the next `showBits`.
+ */
+struct FrameOutStats {
+	/**
+	 * The number of pixels filled from erase lists, and the number of erase
+	 * rects that were joined into neighbouring rects before filling.
+	 */
+	uint32 erasedPixels;
+	uint32 eraseRects;
+	uint32 joinedEraseRects;
+
+	/**
+	 * The number of pixels drawn from screen items.
+	 */
+	uint32 drawnPixels;
+	uint32 drawRects;
+
+	/**
+	 * The number of pixels sent to the backend.
+	 */
+	uint32 shownPixels;
+	uint32 showRects;
+};
+
 /**
  * Frameout class, kFrameOut and relevant functions for SCI32 games.
  * Roughly equivalent to GraphicsMgr in SSCI.
@@ -230,6 +256,13 @@ public:
 		return _currentBuffer;
 	}
 
+	/**
+	 * Returns the pixel counts of the most recently shown frame.
+	 */
+	inline const FrameOutStats &getLastFrameStats() const {
+		return _lastFrameStats;
+	}
+
 	void kernelFrameOut(const bool showBits);
 
 	/**
@@ -328,6 +361,13 @@ private:
 	 */
 	RectList _showList;
 
+	/**
+	 * Pixel counts of the frame currently being drawn, and of the last frame
+	 * that was shown.
+	 */
+	FrameOutStats _frameStats;
+	FrameOutStats _lastFrameStats;
+
 	/**
 	 * A list of DrawLists used by frameOut(). This is a field to avoid
 	 * constructing and destroying DrawLists on every frame.
@@ -364,9 +404,10 @@ private:
 	 * Erases the areas in the given erase list from the visible screen buffer
 	 * by filling them with the color from the corresponding plane. This is an
 	 * optimisation for colored-type planes only; other plane types have to be
-	 * redrawn from pixel data.
+	 * redrawn from pixel data. Adjacent rects of the list are joined first,
+	 * which reduces the number of fills and show list merges.
 	 */
-	void drawEraseList(const RectList &eraseList, const Plane &plane);
+	void drawEraseList(RectList &eraseList, const Plane &plane);
 
 	/**
 	 * Draws all screen items from the given draw list to the visible screen
@@ -387,6 +428,12 @@ private:
 	 */
 	void showBits();
 
+	/**
+	 * Makes the pixel counts gathered since the last shown frame available
+	 * through `getLastFrameStats` and starts counting the next frame.
+	 */
+	void finishFrameStats();
+
 	/**
 	 * Validates whether the given palette index in the style range should copy
 	 * a color from the next palette to the source palette during a palette
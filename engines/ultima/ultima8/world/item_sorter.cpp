@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "ultima/ultima.h"
 #include "ultima/ultima8/misc/common_types.h"
 #include "ultima/ultima8/world/item_sorter.h"
@@ -45,10 +46,24 @@ namespace Ultima8 {
 static const uint32 TRANSPARENT_COLOR = TEX32_PACK_RGBA(0x7F, 0x00, 0x00, 0x7F);
 static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 
+// Size in pixels of the cells of the screenspace grid
+static const int32 GRID_CELL_SIZE = 64;
+
+// Order of items in the sorted display list; equal items are kept in the
+// order they were added
+static bool listOrderLessThan(const SortItem *si1, const SortItem *si2) {
+	if (si1->listLessThan(*si2))
+		return true;
+	if (si2->listLessThan(*si1))
+		return false;
+	return si1->_listIndex < si2->_listIndex;
+}
+
 ItemSorter::ItemSorter(int capacity) :
 	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
 	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
-	_sortLimit(0), _sortLimitChanged(false) {
+	_sortLimit(0), _sortLimitChanged(false), _gridCols(0), _gridRows(0),
+	_addCount(0), _visitMark(0) {
 	int i = capacity;
 	while (i--) {
 		SortItem *next = _itemsUnused;
@@ -87,6 +102,14 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 	_items = nullptr;
 	_itemsTail = nullptr;
 	_painted = nullptr;
+	_addCount = 0;
+
+	// Reset the grid, keeping the storage of the cells for the next list
+	_gridCols = MAX<int32>(1, (clipWindow.width() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	_gridRows = MAX<int32>(1, (clipWindow.height() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	_grid.resize(_gridCols * _gridRows);
+	for (uint i = 0; i < _grid.size(); ++i)
+		_grid[i].resize(0);
 
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	int32 camSx = (cam.x - cam.y) / 4;
@@ -187,15 +210,47 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
-
-	// Ok,
+	// Get the insert point... which is before the first item that has higher z than us
 	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->listLessThan(*si2))
-			addpoint = si2;
+	if (_itemsTail && si->listLessThan(*_itemsTail)) {
+		for (addpoint = _items; !si->listLessThan(*addpoint); addpoint = addpoint->_next) {
+		}
+	}
+
+	// Gather the items in the grid cells we cover. Items can only overlap if
+	// their screenspace rects intersect, so no other item needs checking.
+	// The rect is grown by a pixel so that adjoining items are found as well.
+	if (++_visitMark == 0) {
+		for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next)
+			si2->_visitMark = 0;
+		_visitMark = 1;
+	}
 
+	Rect query = si->_sr;
+	query.grow(1);
+	int32 col1, row1, col2, row2;
+	getGridCells(query, col1, row1, col2, row2);
+
+	_candidates.resize(0);
+	for (int32 row = row1; row <= row2; ++row) {
+		for (int32 col = col1; col <= col2; ++col) {
+			const Common::Array<SortItem *> &cell = _grid[row * _gridCols + col];
+			for (uint i = 0; i < cell.size(); ++i) {
+				SortItem *si2 = cell[i];
+				if (si2->_visitMark != _visitMark) {
+					si2->_visitMark = _visitMark;
+					_candidates.push_back(si2);
+				}
+			}
+		}
+	}
+
+	// Compare in list order, as dependencies between equal items are
+	// ordered by the time they were found
+	Common::sort(_candidates.begin(), _candidates.end(), listOrderLessThan);
+
+	for (uint i = 0; i < _candidates.size(); ++i) {
+		SortItem *si2 = _candidates[i];
 		if (si2->_occluded)
 			continue;
 
@@ -243,6 +298,17 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 		}
 	}
 
+	// Occluded items are skipped by all later checks, so only visible ones
+	// need to be found in the grid
+	si->_listIndex = _addCount++;
+	if (!si->_occluded) {
+		getGridCells(si->_sr, col1, row1, col2, row2);
+		for (int32 row = row1; row <= row2; ++row) {
+			for (int32 col = col1; col <= col2; ++col)
+				_grid[row * _gridCols + col].push_back(si);
+		}
+	}
+
 	// Add it to the list
 	_itemsUnused = _itemsUnused->_next;
 
@@ -269,6 +335,15 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 	}
 }
 
+void ItemSorter::getGridCells(const Rect &r, int32 &col1, int32 &row1, int32 &col2, int32 &row2) const {
+	// Rects outside of the clip window are clamped to the border cells, which
+	// keeps overlapping rects in shared cells
+	col1 = CLIP<int32>((r.left - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridCols - 1);
+	col2 = CLIP<int32>((r.right - 1 - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridCols - 1);
+	row1 = CLIP<int32>((r.top - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridRows - 1);
+	row2 = CLIP<int32>((r.bottom - 1 - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridRows - 1);
+}
+
 void ItemSorter::AddItem(const Item *add) {
 	AddItem(add->getLerped(), add->getShape(), add->getFrame(),
 			add->getFlags(), add->getExtFlags(), add->getObjId());
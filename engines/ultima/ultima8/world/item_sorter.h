@@ -22,6 +22,7 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
 #include "ultima/ultima8/misc/rect.h"
 
 namespace Ultima {
@@ -46,6 +47,15 @@ class ItemSorter {
 	int32       _sortLimit;
 	bool        _sortLimitChanged;
 
+	// Screenspace grid over the clip window. Each cell lists the items whose
+	// shape frame touches it, so new items are only compared against nearby
+	// items instead of the whole list.
+	Common::Array<Common::Array<SortItem *> > _grid;
+	int32       _gridCols, _gridRows;
+	Common::Array<SortItem *> _candidates;
+	uint32      _addCount;
+	uint32      _visitMark;
+
 public:
 	ItemSorter(int capacity);
 	~ItemSorter();
@@ -71,6 +81,9 @@ public:
 
 private:
 	bool PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootpad);
+
+	// Get the range of grid cells covered by the given screenspace rect
+	void getGridCells(const Rect &r, int32 &col1, int32 &row1, int32 &col2, int32 &row2) const;
 };
 
 } // End of namespace Ultima8
@@ -494,6 +494,19 @@ public:
 	 */
 	virtual void drawStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
 
+	/**
+	 * Sets up the renderer state for the specified draw step, exactly as
+	 * drawStep does, without drawing anything.
+	 */
+	void setupStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
+
+	/**
+	 * Returns a hash of the renderer state a draw step may use without
+	 * setting it itself, i.e. the current colors and whether shadows are
+	 * disabled.
+	 */
+	virtual uint32 getStateHash() const = 0;
+
 	/**
 	 * Copies the part of the current frame to the system overlay.
 	 *
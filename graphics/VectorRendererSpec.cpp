@@ -593,6 +593,18 @@ setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) {
 	}
 }
 
+template<typename PixelType>
+uint32 VectorRendererSpec<PixelType>::
+getStateHash() const {
+	uint32 hash = Base::_disableShadows ? 1 : 0;
+	const PixelType colors[] = { _fgColor, _bgColor, _bevelColor, _gradientStart, _gradientEnd };
+
+	for (uint i = 0; i < ARRAYSIZE(colors); ++i)
+		hash = hash * 31 + (uint32)colors[i];
+
+	return hash;
+}
+
 template<typename PixelType>
 inline PixelType VectorRendererSpec<PixelType>::
 calcGradient(uint32 pos, uint32 max) {
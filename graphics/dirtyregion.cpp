@@ -0,0 +1,215 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/dirtyregion.h"
+
+namespace Graphics {
+
+DirtyRegion::DirtyRegion() : _width(0), _height(0), _tileSize(16), _tilesW(0), _tilesH(0) {
+	_stats.totalTiles = 0;
+	clear();
+}
+
+void DirtyRegion::setSize(int width, int height, int tileSize) {
+	assert(width >= 0 && height >= 0 && tileSize > 0);
+
+	_width = width;
+	_height = height;
+	_tileSize = tileSize;
+	_tilesW = (width + tileSize - 1) / tileSize;
+	_tilesH = (height + tileSize - 1) / tileSize;
+	_tiles.resize(_tilesW * _tilesH);
+	_stats.totalTiles = _tilesW * _tilesH;
+	clear();
+}
+
+void DirtyRegion::clear() {
+	if (!_tiles.empty())
+		memset(_tiles.begin(), 0, _tiles.size());
+
+	_stats.addedRects = 0;
+	_stats.dirtyTiles = 0;
+	_stats.outputRects = 0;
+	_stats.outputArea = 0;
+}
+
+void DirtyRegion::addRect(const Common::Rect &r) {
+	if (!r.isValidRect())
+		return;
+
+	Common::Rect area(r);
+	area.clip(Common::Rect(_width, _height));
+	if (area.isEmpty())
+		return;
+
+	_stats.addedRects++;
+
+	const int left = area.left / _tileSize;
+	const int right = (area.right + _tileSize - 1) / _tileSize;
+	const int top = area.top / _tileSize;
+	const int bottom = (area.bottom + _tileSize - 1) / _tileSize;
+
+	for (int y = top; y < bottom; y++) {
+		byte *row = &_tiles[y * _tilesW];
+		for (int x = left; x < right; x++) {
+			if (!row[x]) {
+				row[x] = 1;
+				_stats.dirtyTiles++;
+			}
+		}
+	}
+}
+
+void DirtyRegion::markAll() {
+	if (!_tiles.empty())
+		memset(_tiles.begin(), 1, _tiles.size());
+
+	_stats.addedRects++;
+	_stats.dirtyTiles = _stats.totalTiles;
+}
+
+Common::Rect DirtyRegion::getBoundingRect() const {
+	int left = _tilesW, right = 0, top = _tilesH, bottom = 0;
+
+	for (int y = 0; y < _tilesH; y++) {
+		const byte *row = &_tiles[y * _tilesW];
+		for (int x = 0; x < _tilesW; x++) {
+			if (row[x]) {
+				left = MIN(left, x);
+				right = MAX(right, x + 1);
+				top = MIN(top, y);
+				bottom = y + 1;
+			}
+		}
+	}
+
+	if (left >= right)
+		return Common::Rect();
+
+	return tileRect(left, top, right, bottom);
+}
+
+void DirtyRegion::getRects(Common::Array<Common::Rect> &rects, uint maxRects) {
+	rects.clear();
+	_stats.outputRects = 0;
+	_stats.outputArea = 0;
+
+	if (isEmpty())
+		return;
+
+	if (isFull() || maxRects == 1) {
+		rects.push_back(getBoundingRect());
+	} else {
+		buildRuns(rects, false);
+
+		if (maxRects && rects.size() > maxRects) {
+			// Too fragmented: start over from a single run per tile row, which
+			// keeps the quadratic merging below cheap.
+			rects.clear();
+			buildRuns(rects, true);
+
+			while (rects.size() > maxRects) {
+				uint bestI = 0, bestJ = 1;
+				int bestWaste = 0x7FFFFFFF;
+
+				for (uint i = 0; i < rects.size(); i++) {
+					const int areaI = rects[i].width() * rects[i].height();
+					for (uint j = i + 1; j < rects.size(); j++) {
+						Common::Rect merged(rects[i]);
+						merged.extend(rects[j]);
+						const int waste = merged.width() * merged.height() - areaI - rects[j].width() * rects[j].height();
+						if (waste < bestWaste) {
+							bestWaste = waste;
+							bestI = i;
+							bestJ = j;
+						}
+					}
+				}
+
+				rects[bestI].extend(rects[bestJ]);
+				rects.remove_at(bestJ);
+			}
+		}
+
+		for (uint i = 0; i < rects.size(); i++) {
+			const Common::Rect &r = rects[i];
+			rects[i] = tileRect(r.left, r.top, r.right, r.bottom);
+		}
+	}
+
+	_stats.outputRects = rects.size();
+	for (uint i = 0; i < rects.size(); i++)
+		_stats.outputArea += rects[i].width() * rects[i].height();
+}
+
+void DirtyRegion::buildRuns(Common::Array<Common::Rect> &rects, bool rowBounds) const {
+	// Rects are built in tile units. active holds the indices of the rects
+	// ending on the previous tile row, sorted by their left edge.
+	Common::Array<uint> active, nextActive;
+
+	for (int y = 0; y < _tilesH; y++) {
+		const byte *row = &_tiles[y * _tilesW];
+		uint a = 0;
+		nextActive.clear();
+
+		int x = 0;
+		while (x < _tilesW) {
+			if (!row[x]) {
+				x++;
+				continue;
+			}
+
+			int left = x;
+			int right;
+			if (rowBounds) {
+				right = _tilesW;
+				while (!row[right - 1])
+					right--;
+			} else {
+				right = x + 1;
+				while (right < _tilesW && row[right])
+					right++;
+			}
+			x = right;
+
+			while (a < active.size() && rects[active[a]].left < left)
+				a++;
+
+			if (a < active.size() && rects[active[a]].left == left && rects[active[a]].right == right) {
+				rects[active[a]].bottom = y + 1;
+				nextActive.push_back(active[a]);
+				a++;
+			} else {
+				nextActive.push_back(rects.size());
+				rects.push_back(Common::Rect(left, y, right, y + 1));
+			}
+		}
+
+		active.swap(nextActive);
+	}
+}
+
+Common::Rect DirtyRegion::tileRect(int left, int top, int right, int bottom) const {
+	return Common::Rect(left * _tileSize, top * _tileSize,
+	                    MIN(right * _tileSize, _width), MIN(bottom * _tileSize, _height));
+}
+
+} // End of namespace Graphics
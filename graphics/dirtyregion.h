@@ -0,0 +1,132 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_DIRTYREGION_H
+#define GRAPHICS_DIRTYREGION_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * @defgroup graphics_dirtyregion Dirty region
+ * @ingroup graphics
+ *
+ * @brief Tile based tracking of the modified areas of a screen or texture.
+ *
+ * @{
+ */
+
+/**
+ * Keeps track of the areas of a surface modified during a frame.
+ *
+ * Added rects are recorded in a grid of square tiles, so any number of them
+ * can be added without overflowing a fixed size list. When the frame is
+ * presented, getRects() turns the dirty tiles back into a small list of
+ * tile aligned rects.
+ */
+class DirtyRegion {
+public:
+	/**
+	 * Statistics about the current frame, reset by clear().
+	 */
+	struct Stats {
+		uint addedRects;  ///< Number of non-empty rects passed to addRect().
+		uint dirtyTiles;  ///< Number of tiles marked dirty.
+		uint totalTiles;  ///< Number of tiles in the grid.
+		uint outputRects; ///< Number of rects returned by the last getRects() call.
+		uint outputArea;  ///< Number of pixels covered by those rects.
+	};
+
+	DirtyRegion();
+
+	/**
+	 * Resize the tracked area. This also clears it.
+	 *
+	 * @param width    Width of the tracked surface.
+	 * @param height   Height of the tracked surface.
+	 * @param tileSize Width and height of a tile, in pixels.
+	 */
+	void setSize(int width, int height, int tileSize = 16);
+
+	int getWidth() const { return _width; }
+	int getHeight() const { return _height; }
+	int getTileSize() const { return _tileSize; }
+
+	/**
+	 * Mark the whole area as clean and reset the statistics.
+	 */
+	void clear();
+
+	/**
+	 * Mark the tiles covered by a rect as dirty. The rect is clipped to the
+	 * tracked area.
+	 */
+	void addRect(const Common::Rect &r);
+
+	/**
+	 * Mark the whole area as dirty.
+	 */
+	void markAll();
+
+	bool isEmpty() const { return _stats.dirtyTiles == 0; }
+	bool isFull() const { return _stats.dirtyTiles == _stats.totalTiles; }
+
+	/**
+	 * Return the smallest rect containing every dirty tile, clipped to the
+	 * tracked area.
+	 */
+	Common::Rect getBoundingRect() const;
+
+	/**
+	 * Return the dirty area as a list of tile aligned rects, clipped to the
+	 * tracked area.
+	 *
+	 * Dirty tiles next to each other in a tile row are joined into a run,
+	 * and runs spanning the same columns in consecutive tile rows are joined
+	 * into one rect. When there are more than maxRects of them, the rects
+	 * are merged, starting with the pairs whose union adds the least clean
+	 * area, until maxRects remain. Merged rects may overlap.
+	 *
+	 * @param rects    Receives the rects.
+	 * @param maxRects Maximum number of rects, or 0 for no limit.
+	 */
+	void getRects(Common::Array<Common::Rect> &rects, uint maxRects = 0);
+
+	const Stats &getStats() const { return _stats; }
+
+private:
+	void buildRuns(Common::Array<Common::Rect> &rects, bool rowBounds) const;
+	Common::Rect tileRect(int left, int top, int right, int bottom) const;
+
+	int _width, _height;
+	int _tileSize;
+	int _tilesW, _tilesH;
+	Common::Array<byte> _tiles;
+	Stats _stats;
+};
+
+/** @} */
+
+} // End of namespace Graphics
+
+#endif
@@ -120,6 +120,11 @@ void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, i
 		x = x + w - width;
 	x += deltax;
 
+	// Visible characters are handed to the font in runs
+	uint32 chrs[64];
+	int xs[64];
+	uint count = 0;
+
 	typename StringType::unsigned_type last = 0;
 	for (typename StringType::const_iterator i = str.begin(), end = str.end(); i != end; ++i) {
 		const typename StringType::unsigned_type cur = *i;
@@ -129,11 +134,20 @@ void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, i
 		Common::Rect charBox = font.getBoundingBox(cur);
 		if (x + charBox.right > rightX)
 			break;
-		if (x + charBox.right >= leftX)
-			font.drawChar(dst, cur, x, y, color);
+		if (x + charBox.right >= leftX) {
+			chrs[count] = cur;
+			xs[count] = x;
+			if (++count == ARRAYSIZE(chrs)) {
+				font.drawChars(dst, chrs, xs, count, y, color);
+				count = 0;
+			}
+		}
 
 		x += font.getCharWidth(cur);
 	}
+
+	if (count)
+		font.drawChars(dst, chrs, xs, count, y, color);
 }
 
 template<class StringType>
@@ -467,6 +481,16 @@ void Font::drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color)
 	dst->addDirtyRect(charBox);
 }
 
+void Font::drawChars(Surface *dst, const uint32 *chrs, const int *xs, uint count, int y, uint32 color) const {
+	for (uint i = 0; i < count; ++i)
+		drawChar(dst, chrs[i], xs[i], y, color);
+}
+
+void Font::drawChars(ManagedSurface *dst, const uint32 *chrs, const int *xs, uint count, int y, uint32 color) const {
+	for (uint i = 0; i < count; ++i)
+		drawChar(dst, chrs[i], xs[i], y, color);
+}
+
 void Font::drawString(Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool useEllipsis) const {
 	Common::String renderStr = useEllipsis ? handleEllipsis(*this, str, w) : str;
 	drawStringImpl(*this, dst, renderStr, x, y, w, color, align, deltax);
@@ -212,6 +212,24 @@ public:
 	virtual void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const = 0;
 	virtual void drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const;
 
+	/**
+	 * Draw a run of characters sharing the same baseline, as done by
+	 * drawString.
+	 *
+	 * The default implementation calls drawChar for every character. Fonts
+	 * which can draw a run more efficiently than one character at a time
+	 * may override it.
+	 *
+	 * @param dst   The surface to draw on.
+	 * @param chrs  The characters to draw.
+	 * @param xs    The x coordinate of every character, as passed to drawChar.
+	 * @param count The number of characters.
+	 * @param y     The y coordinate where to draw the characters.
+	 * @param color The color of the characters.
+	 */
+	virtual void drawChars(Surface *dst, const uint32 *chrs, const int *xs, uint count, int y, uint32 color) const;
+	virtual void drawChars(ManagedSurface *dst, const uint32 *chrs, const int *xs, uint count, int y, uint32 color) const;
+
 	/** @overload */
 
 	/**
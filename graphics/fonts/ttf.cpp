@@ -39,6 +39,8 @@
 #include "common/memstream.h"
 #include "common/hashmap.h"
 #include "common/ptr.h"
+#include "common/md5.h"
+#include "common/endian.h"
 #include "common/compression/unzip.h"
 
 #include <ft2build.h>
@@ -87,6 +89,42 @@ inline int divRoundToNearest(int dividend, int divisor) {
 	return (dividend + (divisor / 2)) / divisor;
 }
 
+/**
+ * Identify the font data by the sfnt table directory of the face, which holds
+ * the checksum, offset and length of every table. This saves reading through
+ * the whole file, which can be several megabytes for CJK fonts. Other formats
+ * have no such directory, they are hashed completely.
+ */
+Common::String computeFontDataKey(const uint8 *data, uint32 size, int32 faceIndex) {
+	uint32 offset = 0;
+	if (size >= 12 && READ_BE_UINT32(data) == MKTAG('t', 't', 'c', 'f')) {
+		const uint32 index = faceIndex & 0xFFFF;
+		if (index < READ_BE_UINT32(data + 8) && 16 + index * 4 <= size)
+			offset = READ_BE_UINT32(data + 12 + index * 4);
+		else
+			offset = size;
+	}
+
+	if (offset <= size && size - offset >= 12) {
+		const uint32 version = READ_BE_UINT32(data + offset);
+		const uint32 dirSize = 12 + 16 * READ_BE_UINT16(data + offset + 4);
+		if ((version == 0x00010000 || version == MKTAG('O', 'T', 'T', 'O') || version == MKTAG('t', 'r', 'u', 'e')) &&
+		    dirSize <= size - offset) {
+			Common::MemoryReadStream directory(data + offset, dirSize);
+			return Common::String::format("%s:%u:%u", Common::computeStreamMD5AsString(directory).c_str(), offset, size);
+		}
+	}
+
+	Common::MemoryReadStream fontData(data, size);
+	return Common::String::format("%s:%u", Common::computeStreamMD5AsString(fontData).c_str(), size);
+}
+
+struct GlyphKeyHash {
+	uint operator()(uint64 key) const {
+		return (uint)(key >> 32) * 2654435761u ^ (uint)key;
+	}
+};
+
 } // End of anonymous namespace
 
 class TTFLibrary : public Common::Singleton<TTFLibrary> {
@@ -106,7 +144,331 @@ private:
 	bool _initialized;
 };
 
+/**
+ * Shared storage for the glyph images of all TrueType fonts.
+ *
+ * Glyphs are packed into large CLUT8 pages, in rows of glyphs of similar
+ * height. Fonts loaded from the same face with the same size and rendering
+ * settings get the same id and thus share their glyphs. A page is freed once
+ * no font uses its glyphs anymore. Once the pages use more than kBudget bytes
+ * the least recently used page is dropped, and its glyphs are rendered again
+ * the next time they are drawn.
+ */
+class TTFGlyphAtlas : public Common::Singleton<TTFGlyphAtlas> {
+public:
+	/**
+	 * Placement of a glyph image relative to the pen position.
+	 */
+	struct Metrics {
+		int width, height;
+		int xOffset, yOffset;
+		int advance;
+	};
+
+	/**
+	 * Location of a glyph image. It is only valid until the next call to add.
+	 * Glyphs without an image, like the space, have no page.
+	 */
+	struct Entry {
+		const Surface *page;
+		int x, y;
+		Metrics metrics;
+	};
+
+	TTFGlyphAtlas();
+	~TTFGlyphAtlas();
+
+	/**
+	 * Return the id to use for the glyphs of the font described by key. Each
+	 * call has to be paired with a call to releaseFontId.
+	 */
+	uint32 acquireFontId(const Common::String &key);
+
+	/**
+	 * Drop a reference to a font id. The glyphs of the font are forgotten
+	 * once no font uses the id anymore, and the pages left without glyphs
+	 * are freed.
+	 */
+	void releaseFontId(uint32 fontId);
+
+	bool find(uint32 fontId, FT_UInt slot, Entry &entry);
+	void add(uint32 fontId, FT_UInt slot, const Surface &image, const Metrics &metrics, Entry &entry);
+
+	TTFGlyphAtlasStats getStats() const;
+
+private:
+	enum {
+		kPageSize = 512,
+		kBudget = 8 * 1024 * 1024
+	};
+
+	static const uint kNoPage = 0xFFFFFFFF;
+
+	struct Shelf {
+		int y, height;
+		int x;
+	};
+
+	struct Page {
+		Surface surface;
+		Common::Array<Shelf> shelves;
+		int shelvesBottom;
+		uint32 lastUse;
+		uint liveGlyphs;
+		Common::Array<uint64> glyphs;
+	};
+
+	struct Location {
+		uint page;
+		int x, y;
+		Metrics metrics;
+	};
+
+	struct FontRef {
+		uint32 id;
+		uint refCount;
+	};
+
+	static uint64 makeKey(uint32 fontId, FT_UInt slot) { return ((uint64)fontId << 32) | slot; }
+	void fillEntry(const Location &location, Entry &entry);
+	static bool allocate(Page &page, int w, int h, int &x, int &y);
+	bool evictLeastRecentlyUsed();
+	void freePage(uint index);
+
+	Common::Array<Page *> _pages;
+	typedef Common::HashMap<uint64, Location, GlyphKeyHash> GlyphMap;
+	GlyphMap _glyphs;
+	Common::HashMap<Common::String, FontRef> _fontIds;
+	Common::HashMap<uint32, Common::String> _fontKeys;
+	uint32 _nextFontId;
+	uint32 _usedBytes;
+	uint32 _tick;
+};
+
+#define g_ttfAtlas ::Graphics::TTFGlyphAtlas::instance()
+
+TTFGlyphAtlas::TTFGlyphAtlas() : _nextFontId(1), _usedBytes(0), _tick(0) {
+}
+
+TTFGlyphAtlas::~TTFGlyphAtlas() {
+	for (uint i = 0; i < _pages.size(); ++i) {
+		if (_pages[i]) {
+			_pages[i]->surface.free();
+			delete _pages[i];
+		}
+	}
+}
+
+uint32 TTFGlyphAtlas::acquireFontId(const Common::String &key) {
+	Common::HashMap<Common::String, FontRef>::iterator i = _fontIds.find(key);
+	if (i != _fontIds.end()) {
+		++i->_value.refCount;
+		return i->_value.id;
+	}
+
+	// Ids are never reused, so stale keys in the pages cannot match a new font
+	FontRef ref;
+	ref.id = _nextFontId++;
+	ref.refCount = 1;
+	_fontIds[key] = ref;
+	_fontKeys[ref.id] = key;
+	return ref.id;
+}
+
+void TTFGlyphAtlas::releaseFontId(uint32 fontId) {
+	Common::HashMap<uint32, Common::String>::iterator key = _fontKeys.find(fontId);
+	if (key == _fontKeys.end())
+		return;
+
+	FontRef &ref = _fontIds[key->_value];
+	if (--ref.refCount)
+		return;
+
+	_fontIds.erase(key->_value);
+	_fontKeys.erase(key);
+
+	Common::Array<uint64> unused;
+	for (GlyphMap::const_iterator i = _glyphs.begin(); i != _glyphs.end(); ++i) {
+		if ((uint32)(i->_key >> 32) == fontId)
+			unused.push_back(i->_key);
+	}
+	for (uint i = 0; i < unused.size(); ++i) {
+		GlyphMap::iterator glyph = _glyphs.find(unused[i]);
+		const uint pageIndex = glyph->_value.page;
+		_glyphs.erase(glyph);
+
+		// Space inside a page is not reused, but pages with only glyphs of
+		// released fonts are
+		if (pageIndex != kNoPage && !--_pages[pageIndex]->liveGlyphs)
+			freePage(pageIndex);
+	}
+}
+
+void TTFGlyphAtlas::fillEntry(const Location &location, Entry &entry) {
+	if (location.page == kNoPage) {
+		entry.page = nullptr;
+	} else {
+		Page *page = _pages[location.page];
+		page->lastUse = ++_tick;
+		entry.page = &page->surface;
+	}
+
+	entry.x = location.x;
+	entry.y = location.y;
+	entry.metrics = location.metrics;
+}
+
+bool TTFGlyphAtlas::find(uint32 fontId, FT_UInt slot, Entry &entry) {
+	GlyphMap::const_iterator i = _glyphs.find(makeKey(fontId, slot));
+	if (i == _glyphs.end())
+		return false;
+
+	fillEntry(i->_value, entry);
+	return true;
+}
+
+void TTFGlyphAtlas::add(uint32 fontId, FT_UInt slot, const Surface &image, const Metrics &metrics, Entry &entry) {
+	const uint64 key = makeKey(fontId, slot);
+
+	// Another font with the same id might have added the glyph already
+	GlyphMap::const_iterator existing = _glyphs.find(key);
+	if (existing != _glyphs.end()) {
+		fillEntry(existing->_value, entry);
+		return;
+	}
+
+	Location location;
+	location.page = kNoPage;
+	location.x = location.y = 0;
+	location.metrics = metrics;
+
+	if (image.w <= 0 || image.h <= 0) {
+		_glyphs[key] = location;
+		fillEntry(location, entry);
+		return;
+	}
+
+	for (uint i = 0; i < _pages.size(); ++i) {
+		if (_pages[i] && allocate(*_pages[i], image.w, image.h, location.x, location.y)) {
+			location.page = i;
+			break;
+		}
+	}
+
+	if (location.page == kNoPage) {
+		// Glyphs larger than a page get a page of their own
+		const int width = MAX<int>(image.w, kPageSize);
+		const int height = MAX<int>(image.h, kPageSize);
+
+		while (_usedBytes + width * height > kBudget && evictLeastRecentlyUsed())
+			;
+
+		for (uint i = 0; i < _pages.size(); ++i) {
+			if (!_pages[i]) {
+				location.page = i;
+				break;
+			}
+		}
+		if (location.page == kNoPage) {
+			location.page = _pages.size();
+			_pages.push_back(nullptr);
+		}
+
+		Page *page = new Page();
+		page->surface.create(width, height, PixelFormat::createFormatCLUT8());
+		page->shelvesBottom = 0;
+		page->liveGlyphs = 0;
+		_pages[location.page] = page;
+		_usedBytes += width * height;
+
+		allocate(*page, image.w, image.h, location.x, location.y);
+	}
+
+	Page *page = _pages[location.page];
+	page->surface.copyRectToSurface(image, location.x, location.y, Common::Rect(image.w, image.h));
+	page->glyphs.push_back(key);
+	++page->liveGlyphs;
+	_glyphs[key] = location;
+
+	fillEntry(location, entry);
+}
+
+TTFGlyphAtlasStats TTFGlyphAtlas::getStats() const {
+	TTFGlyphAtlasStats stats;
+	stats.fonts = _fontIds.size();
+	stats.glyphs = _glyphs.size();
+	stats.pages = 0;
+	for (uint i = 0; i < _pages.size(); ++i) {
+		if (_pages[i])
+			++stats.pages;
+	}
+	stats.usedBytes = _usedBytes;
+	return stats;
+}
+
+bool TTFGlyphAtlas::allocate(Page &page, int w, int h, int &x, int &y) {
+	// Reuse a row whose height does not waste more than a quarter of it
+	for (uint i = 0; i < page.shelves.size(); ++i) {
+		Shelf &shelf = page.shelves[i];
+		if (h <= shelf.height && shelf.height <= h + h / 4 + 1 && shelf.x + w <= page.surface.w) {
+			x = shelf.x;
+			y = shelf.y;
+			shelf.x += w;
+			return true;
+		}
+	}
+
+	if (w > page.surface.w || page.shelvesBottom + h > page.surface.h)
+		return false;
+
+	Shelf shelf;
+	shelf.y = page.shelvesBottom;
+	shelf.height = h;
+	shelf.x = w;
+	page.shelves.push_back(shelf);
+	page.shelvesBottom += h;
+
+	x = 0;
+	y = shelf.y;
+	return true;
+}
+
+bool TTFGlyphAtlas::evictLeastRecentlyUsed() {
+	uint oldest = _pages.size();
+	for (uint i = 0; i < _pages.size(); ++i) {
+		if (_pages[i] && (oldest == _pages.size() || _pages[i]->lastUse < _pages[oldest]->lastUse))
+			oldest = i;
+	}
+
+	if (oldest == _pages.size())
+		return false;
+
+	// Only drop the glyphs that still live on this page
+	Page *page = _pages[oldest];
+	for (uint i = 0; i < page->glyphs.size(); ++i) {
+		GlyphMap::iterator glyph = _glyphs.find(page->glyphs[i]);
+		if (glyph != _glyphs.end() && glyph->_value.page == oldest)
+			_glyphs.erase(glyph);
+	}
+
+	freePage(oldest);
+	return true;
+}
+
+void TTFGlyphAtlas::freePage(uint index) {
+	Page *page = _pages[index];
+	_usedBytes -= page->surface.w * page->surface.h;
+	page->surface.free();
+	delete page;
+	_pages[index] = nullptr;
+}
+
+TTFGlyphAtlasStats getTTFGlyphAtlasStats() {
+	return g_ttfAtlas.getStats();
+}
+
 void shutdownTTF() {
+	TTFGlyphAtlas::destroy();
 	TTFLibrary::destroy();
 }
 
@@ -161,6 +523,9 @@ public:
 	void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const override;
 	void drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const override;
 
+	void drawChars(Surface *dst, const uint32 *chrs, const int *xs, uint count, int y, uint32 color) const override;
+	void drawChars(ManagedSurface *dst, const uint32 *chrs, const int *xs, uint count, int y, uint32 color) const override;
+
 private:
 	bool _initialized;
 	FT_Face _face;
@@ -171,16 +536,17 @@ private:
 	int _width, _height;
 	int _ascent, _descent;
 
-	struct Glyph {
-		Surface image;
-		int xOffset, yOffset;
-		int advance;
+	// The images of the glyphs are kept in the shared TTFGlyphAtlas
+	struct Glyph : TTFGlyphAtlas::Metrics {
 		FT_UInt slot;
 	};
 
 	bool cacheGlyph(Glyph &glyph, uint32 chr) const;
+	bool rasterizeGlyph(FT_UInt slot, Glyph &glyph, Surface &image) const;
+	bool getGlyphImage(const Glyph &glyph, TTFGlyphAtlas::Entry &entry) const;
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
 	mutable GlyphCache _glyphs;
+	uint32 _atlasId;
 	bool _allowLateCaching;
 	void assureCached(uint32 chr) const;
 
@@ -191,6 +557,8 @@ private:
 	int computePointSizeFromHeaders(int height) const;
 	void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color,
 		const uint32 *transparentColor) const;
+	void drawGlyph(Surface *dst, const Glyph &glyph, int x, int y, uint32 color,
+		const uint32 *transparentColor) const;
 
 	FT_Int32 _loadFlags;
 	FT_Render_Mode _renderMode;
@@ -202,20 +570,20 @@ private:
 
 TTFFont::TTFFont()
 	: _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
-	  _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
+	  _descent(0), _glyphs(), _atlasId(0), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
 	  _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false) {
 }
 
 TTFFont::~TTFFont() {
+	if (_atlasId)
+		g_ttfAtlas.releaseFontId(_atlasId);
+
 	if (_initialized) {
 		g_ttf.closeFont(_face);
 
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
 }
@@ -367,6 +735,13 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 		_loadFlags |= FT_LOAD_NO_BITMAP;
 	}
 
+	// Fonts loaded from the same data with the same settings render the
+	// same glyphs, so they share them in the atlas
+	_atlasId = g_ttfAtlas.acquireFontId(Common::String::format("%s:%d:%ld:%ld:%d:%d:%d:%d:%d",
+		computeFontDataKey(_ttfFile, _size, faceIndex).c_str(), faceIndex,
+		(long)_face->size->metrics.x_scale, (long)_face->size->metrics.y_scale,
+		(int)_loadFlags, (int)_renderMode, _fakeBold, _fakeItalic, stemDarkening));
+
 	if (!mapping) {
 		// Allow loading of all unicode characters.
 		_allowLateCaching = true;
@@ -599,10 +974,8 @@ Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
 	if (glyphEntry == _glyphs.end()) {
 		return Common::Rect();
 	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
-		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
+		const Glyph &glyph = glyphEntry->_value;
+		return Common::Rect(glyph.xOffset, glyph.yOffset, glyph.xOffset + glyph.width, glyph.yOffset + glyph.height);
 	}
 }
 
@@ -672,6 +1045,42 @@ void TTFFont::drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 col
 	dst->addDirtyRect(charBox);
 }
 
+void TTFFont::drawChars(Surface *dst, const uint32 *chrs, const int *xs, uint count, int y, uint32 color) const {
+	for (uint i = 0; i < count; ++i)
+		drawChar(dst, chrs[i], xs[i], y, color, nullptr);
+}
+
+void TTFFont::drawChars(ManagedSurface *dst, const uint32 *chrs, const int *xs, uint count, int y, uint32 color) const {
+	uint32 transColor = 0;
+	const uint32 *transparentColor = nullptr;
+	if (dst->hasTransparentColor()) {
+		transColor = dst->getTransparentColor();
+		transparentColor = &transColor;
+	}
+
+	// Mark the whole run dirty at once instead of glyph by glyph
+	Common::Rect dirtyRect;
+	for (uint i = 0; i < count; ++i) {
+		assureCached(chrs[i]);
+		GlyphCache::const_iterator glyphEntry = _glyphs.find(chrs[i]);
+		if (glyphEntry == _glyphs.end())
+			continue;
+
+		const Glyph &glyph = glyphEntry->_value;
+		drawGlyph(dst->surfacePtr(), glyph, xs[i], y, color, transparentColor);
+
+		Common::Rect charBox(glyph.xOffset, glyph.yOffset, glyph.xOffset + glyph.width, glyph.yOffset + glyph.height);
+		charBox.translate(xs[i], y);
+		if (dirtyRect.isEmpty())
+			dirtyRect = charBox;
+		else if (!charBox.isEmpty())
+			dirtyRect.extend(charBox);
+	}
+
+	if (!dirtyRect.isEmpty())
+		dst->addDirtyRect(dirtyRect);
+}
+
 void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 		const uint32 *transparentColor) const {
 	assureCached(chr);
@@ -679,8 +1088,11 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 	if (glyphEntry == _glyphs.end())
 		return;
 
-	const Glyph &glyph = glyphEntry->_value;
+	drawGlyph(dst, glyphEntry->_value, x, y, color, transparentColor);
+}
 
+void TTFFont::drawGlyph(Surface *dst, const Glyph &glyph, int x, int y, uint32 color,
+		const uint32 *transparentColor) const {
 	x += glyph.xOffset;
 	y += glyph.yOffset;
 
@@ -689,10 +1101,18 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 	if (y > dst->h)
 		return;
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
+	int w = glyph.width;
+	int h = glyph.height;
+
+	if (w <= 0 || h <= 0)
+		return;
+
+	TTFGlyphAtlas::Entry entry;
+	if (!getGlyphImage(glyph, entry))
+		return;
 
-	const uint8 *srcPos = (const uint8 *)glyph.image.getPixels();
+	const uint8 *srcPos = (const uint8 *)entry.page->getBasePtr(entry.x, entry.y);
+	const int srcPitch = entry.page->pitch;
 
 	// Make sure we are not drawing outside the screen bounds
 	if (x < 0) {
@@ -708,7 +1128,7 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 		return;
 
 	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
+		srcPos -= y * srcPitch;
 		h += y;
 		y = 0;
 	}
@@ -737,14 +1157,14 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 			}
 
 			dstPos += dst->pitch;
-			srcPos += glyph.image.pitch;
+			srcPos += srcPitch;
 		}
 	} else if (dst->format.bytesPerPixel == 1) {
-		renderGlyph<uint8>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint8>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
 	} else if (dst->format.bytesPerPixel == 2) {
-		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
 	} else if (dst->format.bytesPerPixel == 4) {
-		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
 	}
 }
 
@@ -753,6 +1173,44 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	if (!slot)
 		return false;
 
+	// Another instance of the font might have rendered the glyph already
+	TTFGlyphAtlas::Entry entry;
+	if (g_ttfAtlas.find(_atlasId, slot, entry)) {
+		static_cast<TTFGlyphAtlas::Metrics &>(glyph) = entry.metrics;
+		glyph.slot = slot;
+		return true;
+	}
+
+	Surface image;
+	if (!rasterizeGlyph(slot, glyph, image))
+		return false;
+
+	g_ttfAtlas.add(_atlasId, slot, image, glyph, entry);
+	image.free();
+	return true;
+}
+
+bool TTFFont::getGlyphImage(const Glyph &glyph, TTFGlyphAtlas::Entry &entry) const {
+	if (g_ttfAtlas.find(_atlasId, glyph.slot, entry))
+		return entry.page != nullptr;
+
+	// The atlas page holding the glyph was evicted, render it again
+	Glyph metrics;
+	Surface image;
+	if (!rasterizeGlyph(glyph.slot, metrics, image))
+		return false;
+
+	if (image.w != glyph.width || image.h != glyph.height) {
+		image.free();
+		return false;
+	}
+
+	g_ttfAtlas.add(_atlasId, glyph.slot, image, metrics, entry);
+	image.free();
+	return entry.page != nullptr;
+}
+
+bool TTFFont::rasterizeGlyph(FT_UInt slot, Glyph &glyph, Surface &image) const {
 	glyph.slot = slot;
 
 	// We use the light target and render mode to improve the looks of the
@@ -813,7 +1271,9 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 
 
-	glyph.image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
+	glyph.width = bitmap->width;
+	glyph.height = bitmap->rows;
+	image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
 
 	const uint8 *src = bitmap->buffer;
 	int srcPitch = bitmap->pitch;
@@ -822,7 +1282,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		srcPitch = -srcPitch;
 	}
 
-	uint8 *dst = (uint8 *)glyph.image.getPixels();
+	uint8 *dst = (uint8 *)image.getPixels();
 
 	switch (bitmap->pixel_mode) {
 	case FT_PIXEL_MODE_MONO:
@@ -848,14 +1308,14 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	case FT_PIXEL_MODE_GRAY:
 		for (int y = 0; y < (int)bitmap->rows; ++y) {
 			memcpy(dst, src, bitmap->width);
-			dst += glyph.image.pitch;
+			dst += image.pitch;
 			src += srcPitch;
 		}
 		break;
 
 	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
-		glyph.image.free();
+		warning("TTFFont::rasterizeGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
+		image.free();
 		return false;
 	}
 
@@ -1108,6 +1568,7 @@ Font *findTTFace(const Common::Array<Common::Path> &files, const Common::U32Stri
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::TTFLibrary);
+DECLARE_SINGLETON(Graphics::TTFGlyphAtlas);
 } // End of namespace Common
 
 #endif
@@ -142,6 +142,18 @@ Font *loadTTFFontFromArchive(const Common::String &filename, int size, TTFSizeMo
  */
 Font *findTTFace(const Common::Array<Common::Path> &files, const Common::U32String &faceName, bool bold, bool italic, int size, uint xdpi = 0, uint ydpi = 0,TTFRenderMode renderMode = kTTFRenderModeLight, const uint32 *mapping = 0);
 
+/**
+ * Usage of the glyph atlas shared by all TrueType fonts.
+ */
+struct TTFGlyphAtlasStats {
+	uint fonts;       ///< Number of distinct fonts using the atlas
+	uint glyphs;      ///< Number of glyphs in the atlas
+	uint pages;       ///< Number of pages allocated
+	uint32 usedBytes; ///< Memory used by the pages
+};
+
+TTFGlyphAtlasStats getTTFGlyphAtlasStats();
+
 void shutdownTTF();
 
 } // End of namespace Graphics
@@ -3618,6 +3618,11 @@ public:
 
 	bool canDrawCursor() const override { return false; }
 	bool useOldSource() const override { return true; }
+	// The state of the pixel being scaled is kept in EdgeScaler (_bptr,
+	// _simSum, _greyscaleDiffs and _bplanes), and SourceScaler updates the
+	// old source rows of a band right after scaling it, while the neighbouring
+	// bands still compare their edge rows with them
+	bool canScaleInBands() const override { return false; }
 	uint extraPixels() const override { return 1; }
 	const char *getName() const override;
 	const char *getPrettyName() const override;
@@ -199,6 +199,15 @@ public:
 	 */
 	virtual bool useOldSource() const { return false; }
 
+	/**
+	 * Indicates whether different horizontal bands of a rect may be scaled
+	 * at the same time from several threads, using the same Scaler instance.
+	 * Each band still reads extraPixels() rows above and below itself from
+	 * the source, so the result is identical to scaling the rect at once.
+	 * Scalers keeping per call state in the Scaler instance must return false.
+	 */
+	virtual bool canScaleInBands() const { return true; }
+
 protected:
 	Common::Array<uint> _factors;
 };
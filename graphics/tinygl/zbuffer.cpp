@@ -49,6 +49,9 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 		_sbuf = (byte *)gl_zalloc(_pbufWidth * _pbufHeight * sizeof(byte));
 	else
 		_sbuf = nullptr;
+	// Depth test results of a whole span, the SIMD span functions write 8 at a time
+	_depthSpanMask = (byte *)gl_malloc(_pbufWidth + 8);
+	_depthSpanFunc = Internal::getDepthSpanFunc();
 
 	_offscreenBuffer.pbuf = _pbuf;
 	_offscreenBuffer.zbuf = _zbuf;
@@ -63,6 +66,7 @@ FrameBuffer::~FrameBuffer() {
 	gl_free(_zbuf);
 	if (_sbuf)
 		gl_free(_sbuf);
+	gl_free(_depthSpanMask);
 }
 
 Buffer *FrameBuffer::genOffscreenBuffer() {
@@ -31,6 +31,7 @@
 #include "graphics/surface.h"
 #include "graphics/tinygl/texelbuffer.h"
 #include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/zspan.h"
 
 #include "common/rect.h"
 #include "common/textconsole.h"
@@ -356,22 +357,25 @@ private:
 		}
 	}
 
+	template <bool kEnableScissor, bool kStencilEnabled, bool kStippleEnabled, bool kDepthTestEnabled>
+	bool testPixel(byte *ps, const byte *pm, int _a, int x, int y);
+
 	template <bool kDepthWrite, bool kSmoothMode, bool kFogMode, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending, bool kStencilEnabled, bool kStippleEnabled, bool kDepthTestEnabled>
-	void putPixelNoTexture(int fbOffset, uint *pz, byte *ps, int _a,
+	void putPixelNoTexture(int fbOffset, uint *pz, byte *ps, const byte *pm, int _a,
 	                       int x, int y, uint &z, uint &r, uint &g, uint &b, uint &a,
 	                       int &dzdx, int &drdx, int &dgdx, int &dbdx, uint dadx,
 	                       uint &fog, int fog_r, int fog_g, int fog_b, int &dfdx);
 
 	template <bool kDepthWrite, bool kLightsMode, bool kSmoothMode, bool kFogMode, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending, bool kStencilEnabled, bool kDepthTestEnabled>
 	void putPixelTexture(int fbOffset, const TexelBuffer *texture,
-	                     uint wrap_s, uint wrap_t, uint *pz, byte *ps, int _a,
+	                     uint wrap_s, uint wrap_t, uint *pz, byte *ps, const byte *pm, int _a,
 	                     int x, int y, uint &z, int &t, int &s,
 	                     uint &r, uint &g, uint &b, uint &a,
 	                     int &dzdx, int &dsdx, int &dtdx, int &drdx, int &dgdx, int &dbdx, uint dadx,
 	                     uint &fog, int fog_r, int fog_g, int fog_b, int &dfdx);
 
 	template <bool kDepthWrite, bool kEnableScissor, bool kStencilEnabled, bool StippleEnabled, bool kDepthTestEnabled>
-	void putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &z, int &dzdx);
+	void putPixelDepth(uint *pz, byte *ps, const byte *pm, int _a, int x, int y, uint &z, int &dzdx);
 
 
 	template <bool kEnableAlphaTest>
@@ -764,6 +768,8 @@ private:
 
 	uint *_zbuf;
 	byte *_sbuf;
+	byte *_depthSpanMask;
+	Internal::DepthSpanFunc _depthSpanFunc;
 
 	bool _enableStencil;
 	int _textureSize;
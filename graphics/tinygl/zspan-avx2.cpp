@@ -0,0 +1,121 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_AVX2
+
+#include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/zspan.h"
+
+#include <immintrin.h>
+
+#ifdef __GNUC__
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace TinyGL {
+
+namespace Internal {
+
+// AVX2 only has signed 32-bit compares: depths are biased by 2^31 first.
+template <int kDepthFunc>
+static FORCEINLINE __m256i compareDepth(__m256i zSrc, __m256i zDst) {
+	switch (kDepthFunc) {
+	case TGL_LESS:
+		return _mm256_cmpgt_epi32(zSrc, zDst);
+	case TGL_EQUAL:
+		return _mm256_cmpeq_epi32(zDst, zSrc);
+	case TGL_LEQUAL:
+		return _mm256_xor_si256(_mm256_cmpgt_epi32(zDst, zSrc), _mm256_set1_epi32(-1));
+	case TGL_GREATER:
+		return _mm256_cmpgt_epi32(zDst, zSrc);
+	case TGL_NOTEQUAL:
+		return _mm256_xor_si256(_mm256_cmpeq_epi32(zDst, zSrc), _mm256_set1_epi32(-1));
+	case TGL_GEQUAL:
+		return _mm256_xor_si256(_mm256_cmpgt_epi32(zSrc, zDst), _mm256_set1_epi32(-1));
+	case TGL_ALWAYS:
+		return _mm256_set1_epi32(-1);
+	default:
+		return _mm256_setzero_si256();
+	}
+}
+
+template <int kDepthFunc>
+static void depthSpan(uint *pz, uint z, int dzdx, int count, bool depthWrite, byte *passMask) {
+	const __m256i bias = _mm256_set1_epi32((int)0x80000000);
+	const __m256i step = _mm256_set1_epi32((int)((uint)dzdx * 8));
+	__m256i zSrc = _mm256_add_epi32(_mm256_set1_epi32((int)z), _mm256_mullo_epi32(_mm256_set1_epi32(dzdx), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i dst = _mm256_loadu_si256((const __m256i *)(pz + i));
+		__m256i pass = compareDepth<kDepthFunc>(_mm256_xor_si256(zSrc, bias), _mm256_xor_si256(dst, bias));
+		if (depthWrite)
+			_mm256_storeu_si256((__m256i *)(pz + i), _mm256_blendv_epi8(dst, zSrc, pass));
+		__m128i pass16 = _mm_packs_epi32(_mm256_castsi256_si128(pass), _mm256_extracti128_si256(pass, 1));
+		_mm_storel_epi64((__m128i *)(passMask + i), _mm_packs_epi16(pass16, _mm_setzero_si128()));
+		zSrc = _mm256_add_epi32(zSrc, step);
+	}
+
+	if (i < count)
+		depthSpanGeneric(pz + i, z + (uint)dzdx * i, dzdx, count - i, kDepthFunc, depthWrite, passMask + i);
+}
+
+void depthSpanAVX2(uint *pz, uint z, int dzdx, int count, int depthFunc, bool depthWrite, byte *passMask) {
+	switch (depthFunc) {
+	case TGL_LESS:
+		depthSpan<TGL_LESS>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_EQUAL:
+		depthSpan<TGL_EQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_LEQUAL:
+		depthSpan<TGL_LEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_GREATER:
+		depthSpan<TGL_GREATER>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_NOTEQUAL:
+		depthSpan<TGL_NOTEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_GEQUAL:
+		depthSpan<TGL_GEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_ALWAYS:
+		depthSpan<TGL_ALWAYS>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	default:
+		depthSpan<TGL_NEVER>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	}
+}
+
+} // end of namespace Internal
+
+} // end of namespace TinyGL
+
+#ifdef __GNUC__
+#pragma GCC pop_options
+#endif
+
+#endif // SCUMMVM_AVX2
@@ -0,0 +1,130 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/zspan.h"
+
+#include <arm_neon.h>
+
+#ifdef __GNUC__
+#pragma GCC push_options
+
+#if !defined(__aarch64__)
+#pragma GCC target("fpu=neon")
+#endif // !defined(__aarch64__)
+
+#endif // __GNUC__
+
+namespace TinyGL {
+
+namespace Internal {
+
+template <int kDepthFunc>
+static FORCEINLINE uint32x4_t compareDepth(uint32x4_t zSrc, uint32x4_t zDst) {
+	switch (kDepthFunc) {
+	case TGL_LESS:
+		return vcltq_u32(zDst, zSrc);
+	case TGL_EQUAL:
+		return vceqq_u32(zDst, zSrc);
+	case TGL_LEQUAL:
+		return vcleq_u32(zDst, zSrc);
+	case TGL_GREATER:
+		return vcgtq_u32(zDst, zSrc);
+	case TGL_NOTEQUAL:
+		return vmvnq_u32(vceqq_u32(zDst, zSrc));
+	case TGL_GEQUAL:
+		return vcgeq_u32(zDst, zSrc);
+	case TGL_ALWAYS:
+		return vdupq_n_u32(0xFFFFFFFF);
+	default:
+		return vdupq_n_u32(0);
+	}
+}
+
+template <int kDepthFunc>
+static void depthSpan(uint *pz, uint z, int dzdx, int count, bool depthWrite, byte *passMask) {
+	static const uint32 kLaneIndex[4] = { 0, 1, 2, 3 };
+	const uint32x4_t step = vdupq_n_u32((uint)dzdx * 8);
+	uint32x4_t zLo = vmlaq_n_u32(vdupq_n_u32(z), vld1q_u32(kLaneIndex), (uint)dzdx);
+	uint32x4_t zHi = vaddq_u32(zLo, vdupq_n_u32((uint)dzdx * 4));
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		uint32x4_t dstLo = vld1q_u32(pz + i);
+		uint32x4_t dstHi = vld1q_u32(pz + i + 4);
+		uint32x4_t passLo = compareDepth<kDepthFunc>(zLo, dstLo);
+		uint32x4_t passHi = compareDepth<kDepthFunc>(zHi, dstHi);
+		if (depthWrite) {
+			vst1q_u32(pz + i, vbslq_u32(passLo, zLo, dstLo));
+			vst1q_u32(pz + i + 4, vbslq_u32(passHi, zHi, dstHi));
+		}
+		uint16x8_t pass16 = vcombine_u16(vmovn_u32(passLo), vmovn_u32(passHi));
+		vst1_u8(passMask + i, vmovn_u16(pass16));
+		zLo = vaddq_u32(zLo, step);
+		zHi = vaddq_u32(zHi, step);
+	}
+
+	if (i < count)
+		depthSpanGeneric(pz + i, z + (uint)dzdx * i, dzdx, count - i, kDepthFunc, depthWrite, passMask + i);
+}
+
+void depthSpanNEON(uint *pz, uint z, int dzdx, int count, int depthFunc, bool depthWrite, byte *passMask) {
+	switch (depthFunc) {
+	case TGL_LESS:
+		depthSpan<TGL_LESS>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_EQUAL:
+		depthSpan<TGL_EQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_LEQUAL:
+		depthSpan<TGL_LEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_GREATER:
+		depthSpan<TGL_GREATER>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_NOTEQUAL:
+		depthSpan<TGL_NOTEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_GEQUAL:
+		depthSpan<TGL_GEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_ALWAYS:
+		depthSpan<TGL_ALWAYS>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	default:
+		depthSpan<TGL_NEVER>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	}
+}
+
+} // end of namespace Internal
+
+} // end of namespace TinyGL
+
+#ifdef __GNUC__
+#pragma GCC pop_options
+#endif
+
+#endif // SCUMMVM_NEON
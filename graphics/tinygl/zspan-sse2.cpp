@@ -0,0 +1,131 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/zspan.h"
+
+#include <emmintrin.h>
+
+#ifdef __GNUC__
+#pragma GCC push_options
+
+#ifndef __x86_64__
+#pragma GCC target("sse2")
+#endif
+
+#endif
+
+namespace TinyGL {
+
+namespace Internal {
+
+// SSE2 only has signed 32-bit compares: depths are biased by 2^31 first.
+template <int kDepthFunc>
+static FORCEINLINE __m128i compareDepth(__m128i zSrc, __m128i zDst) {
+	switch (kDepthFunc) {
+	case TGL_LESS:
+		return _mm_cmplt_epi32(zDst, zSrc);
+	case TGL_EQUAL:
+		return _mm_cmpeq_epi32(zDst, zSrc);
+	case TGL_LEQUAL:
+		return _mm_xor_si128(_mm_cmpgt_epi32(zDst, zSrc), _mm_set1_epi32(-1));
+	case TGL_GREATER:
+		return _mm_cmpgt_epi32(zDst, zSrc);
+	case TGL_NOTEQUAL:
+		return _mm_xor_si128(_mm_cmpeq_epi32(zDst, zSrc), _mm_set1_epi32(-1));
+	case TGL_GEQUAL:
+		return _mm_xor_si128(_mm_cmplt_epi32(zDst, zSrc), _mm_set1_epi32(-1));
+	case TGL_ALWAYS:
+		return _mm_set1_epi32(-1);
+	default:
+		return _mm_setzero_si128();
+	}
+}
+
+template <int kDepthFunc>
+static void depthSpan(uint *pz, uint z, int dzdx, int count, bool depthWrite, byte *passMask) {
+	const __m128i bias = _mm_set1_epi32((int)0x80000000);
+	const __m128i step = _mm_set1_epi32((int)((uint)dzdx * 8));
+	__m128i zLo = _mm_setr_epi32((int)z, (int)(z + (uint)dzdx), (int)(z + (uint)dzdx * 2), (int)(z + (uint)dzdx * 3));
+	__m128i zHi = _mm_add_epi32(zLo, _mm_set1_epi32((int)((uint)dzdx * 4)));
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128i dstLo = _mm_loadu_si128((const __m128i *)(pz + i));
+		__m128i dstHi = _mm_loadu_si128((const __m128i *)(pz + i + 4));
+		__m128i passLo = compareDepth<kDepthFunc>(_mm_xor_si128(zLo, bias), _mm_xor_si128(dstLo, bias));
+		__m128i passHi = compareDepth<kDepthFunc>(_mm_xor_si128(zHi, bias), _mm_xor_si128(dstHi, bias));
+		if (depthWrite) {
+			_mm_storeu_si128((__m128i *)(pz + i), _mm_or_si128(_mm_and_si128(passLo, zLo), _mm_andnot_si128(passLo, dstLo)));
+			_mm_storeu_si128((__m128i *)(pz + i + 4), _mm_or_si128(_mm_and_si128(passHi, zHi), _mm_andnot_si128(passHi, dstHi)));
+		}
+		__m128i pass = _mm_packs_epi16(_mm_packs_epi32(passLo, passHi), _mm_setzero_si128());
+		_mm_storel_epi64((__m128i *)(passMask + i), pass);
+		zLo = _mm_add_epi32(zLo, step);
+		zHi = _mm_add_epi32(zHi, step);
+	}
+
+	if (i < count)
+		depthSpanGeneric(pz + i, z + (uint)dzdx * i, dzdx, count - i, kDepthFunc, depthWrite, passMask + i);
+}
+
+void depthSpanSSE2(uint *pz, uint z, int dzdx, int count, int depthFunc, bool depthWrite, byte *passMask) {
+	switch (depthFunc) {
+	case TGL_LESS:
+		depthSpan<TGL_LESS>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_EQUAL:
+		depthSpan<TGL_EQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_LEQUAL:
+		depthSpan<TGL_LEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_GREATER:
+		depthSpan<TGL_GREATER>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_NOTEQUAL:
+		depthSpan<TGL_NOTEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_GEQUAL:
+		depthSpan<TGL_GEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_ALWAYS:
+		depthSpan<TGL_ALWAYS>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	default:
+		depthSpan<TGL_NEVER>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	}
+}
+
+} // end of namespace Internal
+
+} // end of namespace TinyGL
+
+#ifdef __GNUC__
+#pragma GCC pop_options
+#endif
+
+#endif // SCUMMVM_SSE2
@@ -0,0 +1,109 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/system.h"
+
+#include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/zspan.h"
+
+namespace TinyGL {
+
+namespace Internal {
+
+template <int kDepthFunc>
+static FORCEINLINE bool compareDepth(uint zSrc, uint zDst) {
+	switch (kDepthFunc) {
+	case TGL_LESS:
+		return zDst < zSrc;
+	case TGL_EQUAL:
+		return zDst == zSrc;
+	case TGL_LEQUAL:
+		return zDst <= zSrc;
+	case TGL_GREATER:
+		return zDst > zSrc;
+	case TGL_NOTEQUAL:
+		return zDst != zSrc;
+	case TGL_GEQUAL:
+		return zDst >= zSrc;
+	case TGL_ALWAYS:
+		return true;
+	default:
+		return false;
+	}
+}
+
+template <int kDepthFunc>
+static void depthSpan(uint *pz, uint z, int dzdx, int count, bool depthWrite, byte *passMask) {
+	for (int i = 0; i < count; i++) {
+		bool pass = compareDepth<kDepthFunc>(z, pz[i]);
+		passMask[i] = pass ? 0xFF : 0;
+		if (depthWrite && pass)
+			pz[i] = z;
+		z += dzdx;
+	}
+}
+
+void depthSpanGeneric(uint *pz, uint z, int dzdx, int count, int depthFunc, bool depthWrite, byte *passMask) {
+	switch (depthFunc) {
+	case TGL_LESS:
+		depthSpan<TGL_LESS>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_EQUAL:
+		depthSpan<TGL_EQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_LEQUAL:
+		depthSpan<TGL_LEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_GREATER:
+		depthSpan<TGL_GREATER>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_NOTEQUAL:
+		depthSpan<TGL_NOTEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_GEQUAL:
+		depthSpan<TGL_GEQUAL>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	case TGL_ALWAYS:
+		depthSpan<TGL_ALWAYS>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	default:
+		depthSpan<TGL_NEVER>(pz, z, dzdx, count, depthWrite, passMask);
+		break;
+	}
+}
+
+DepthSpanFunc getDepthSpanFunc() {
+	DepthSpanFunc func = depthSpanGeneric;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) func = depthSpanNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) func = depthSpanSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) func = depthSpanAVX2;
+#endif
+	return func;
+}
+
+} // end of namespace Internal
+
+} // end of namespace TinyGL
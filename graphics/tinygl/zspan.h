@@ -0,0 +1,59 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_TINYGL_ZSPAN_H
+#define GRAPHICS_TINYGL_ZSPAN_H
+
+#include "common/scummsys.h"
+
+namespace TinyGL {
+
+namespace Internal {
+
+/**
+ * Runs the depth test for count consecutive pixels of a span. The depth of the
+ * first pixel is z and it advances by dzdx for every following pixel.
+ * passMask[i] is set to 0xFF when pixel i passes the test and to 0 otherwise.
+ * When depthWrite is set, the depth of every passing pixel is also stored in pz.
+ */
+typedef void (*DepthSpanFunc)(uint *pz, uint z, int dzdx, int count, int depthFunc, bool depthWrite, byte *passMask);
+
+void depthSpanGeneric(uint *pz, uint z, int dzdx, int count, int depthFunc, bool depthWrite, byte *passMask);
+#ifdef SCUMMVM_NEON
+void depthSpanNEON(uint *pz, uint z, int dzdx, int count, int depthFunc, bool depthWrite, byte *passMask);
+#endif
+#ifdef SCUMMVM_SSE2
+void depthSpanSSE2(uint *pz, uint z, int dzdx, int count, int depthFunc, bool depthWrite, byte *passMask);
+#endif
+#ifdef SCUMMVM_AVX2
+void depthSpanAVX2(uint *pz, uint z, int dzdx, int count, int depthFunc, bool depthWrite, byte *passMask);
+#endif
+
+/**
+ * Returns the fastest depth span function supported by the running CPU.
+ */
+DepthSpanFunc getDepthSpanFunc();
+
+} // end of namespace Internal
+
+} // end of namespace TinyGL
+
+#endif
@@ -45,36 +45,40 @@ static bool applyStipplePattern(int x, int y, const byte *stipple) {
 	return (stipple[byteIndex] & bitmask);
 }
 
-template <bool kDepthWrite, bool kSmoothMode, bool kFogMode, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending, bool kStencilEnabled, bool kStippleEnabled, bool kDepthTestEnabled>
-void FrameBuffer::putPixelNoTexture(int fbOffset, uint *pz, byte *ps, int _a,
-                                    int x, int y, uint &z, uint &r, uint &g, uint &b, uint &a,
-                                    int &dzdx, int &drdx, int &dgdx, int &dbdx, uint dadx,
-                                    uint &fog, int fog_r, int fog_g, int fog_b, int &dfdx) {
+template <bool kEnableScissor, bool kStencilEnabled, bool kStippleEnabled, bool kDepthTestEnabled>
+FORCEINLINE bool FrameBuffer::testPixel(byte *ps, const byte *pm, int _a, int x, int y) {
 	if (kEnableScissor && scissorPixel(x + _a, y)) {
-		return;
+		return false;
 	}
 
 	if (kStippleEnabled && !applyStipplePattern(x + _a, y, _polygonStipplePattern)) {
-		return;
+		return false;
 	}
 
 	if (kStencilEnabled) {
 		bool stencilResult = stencilTest(ps[_a]);
 		if (!stencilResult) {
 			stencilOp(false, true, ps + _a);
-			return;
+			return false;
 		}
 	}
-	bool depthTestResult;
-	if (kDepthTestEnabled) {
-		depthTestResult = compareDepth(z, pz[_a]);
-	} else {
-		depthTestResult = true;
-	}
+	// The depth test of the whole span was run by the span function beforehand
+	bool depthTestResult = kDepthTestEnabled ? pm[_a] != 0 : true;
 	if (kStencilEnabled) {
 		stencilOp(true, depthTestResult, ps + _a);
 	}
-	if (depthTestResult) {
+	return depthTestResult;
+}
+
+// Rejected pixels still advance the interpolated values, so that every pixel of a
+// span gets the same values no matter which part of the span is clipped away.
+
+template <bool kDepthWrite, bool kSmoothMode, bool kFogMode, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending, bool kStencilEnabled, bool kStippleEnabled, bool kDepthTestEnabled>
+void FrameBuffer::putPixelNoTexture(int fbOffset, uint *pz, byte *ps, const byte *pm, int _a,
+                                    int x, int y, uint &z, uint &r, uint &g, uint &b, uint &a,
+                                    int &dzdx, int &drdx, int &dgdx, int &dbdx, uint dadx,
+                                    uint &fog, int fog_r, int fog_g, int fog_b, int &dfdx) {
+	if (testPixel<kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(ps, pm, _a, x, y)) {
 		writePixel<kEnableAlphaTest, kEnableBlending, kDepthWrite, kFogMode>
 		          (fbOffset + _a, a >> (ZB_POINT_ALPHA_BITS - 8), r >> (ZB_POINT_RED_BITS - 8), g >> (ZB_POINT_GREEN_BITS - 8), b >> (ZB_POINT_BLUE_BITS - 8),
 		          z, fog, fog_r, fog_g, fog_b);
@@ -93,32 +97,12 @@ void FrameBuffer::putPixelNoTexture(int fbOffset, uint *pz, byte *ps, int _a,
 
 template <bool kDepthWrite, bool kLightsMode, bool kSmoothMode, bool kFogMode, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending, bool kStencilEnabled, bool kDepthTestEnabled>
 void FrameBuffer::putPixelTexture(int fbOffset, const TexelBuffer *texture,
-                                  uint wrap_s, uint wrap_t, uint *pz, byte *ps, int _a,
+                                  uint wrap_s, uint wrap_t, uint *pz, byte *ps, const byte *pm, int _a,
                                   int x, int y, uint &z, int &t, int &s,
                                   uint &r, uint &g, uint &b, uint &a,
                                   int &dzdx, int &dsdx, int &dtdx, int &drdx, int &dgdx, int &dbdx, uint dadx,
                                   uint &fog, int fog_r, int fog_g, int fog_b, int &dfdx) {
-	if (kEnableScissor && scissorPixel(x + _a, y)) {
-		return;
-	}
-
-	if (kStencilEnabled) {
-		bool stencilResult = stencilTest(ps[_a]);
-		if (!stencilResult) {
-			stencilOp(false, true, ps + _a);
-			return;
-		}
-	}
-	bool depthTestResult;
-	if (kDepthTestEnabled) {
-		depthTestResult = compareDepth(z, pz[_a]);
-	} else {
-		depthTestResult = true;
-	}
-	if (kStencilEnabled) {
-		stencilOp(true, depthTestResult, ps + _a);
-	}
-	if (depthTestResult) {
+	if (testPixel<kEnableScissor, kStencilEnabled, false, kDepthTestEnabled>(ps, pm, _a, x, y)) {
 		uint8 c_a, c_r, c_g, c_b;
 		texture->getARGBAt(wrap_s, wrap_t, s, t, c_a, c_r, c_g, c_b);
 		if (kLightsMode) {
@@ -148,31 +132,8 @@ void FrameBuffer::putPixelTexture(int fbOffset, const TexelBuffer *texture,
 }
 
 template <bool kDepthWrite, bool kEnableScissor, bool kStencilEnabled, bool kStippleEnabled, bool kDepthTestEnabled>
-void FrameBuffer::putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &z, int &dzdx) {
-	if (kEnableScissor && scissorPixel(x + _a, y)) {
-		return;
-	}
-
-	/*if (kStippleEnabled && !applyStipplePattern(x + _a, y, _polygonStipplePattern)) {
-		return;
-	}*/
-
-	if (kStencilEnabled) {
-		bool stencilResult = stencilTest(ps[_a]);
-		if (!stencilResult) {
-			stencilOp(false, true, ps + _a);
-			return;
-		}
-	}
-	bool depthTestResult;
-	if (kDepthTestEnabled) {
-		depthTestResult = compareDepth(z, pz[_a]);
-	} else {
-		depthTestResult = true;
-	}
-	if (kStencilEnabled) {
-		stencilOp(true, depthTestResult, ps + _a);
-	}
+void FrameBuffer::putPixelDepth(uint *pz, byte *ps, const byte *pm, int _a, int x, int y, uint &z, int &dzdx) {
+	bool depthTestResult = testPixel<kEnableScissor, kStencilEnabled, false, kDepthTestEnabled>(ps, pm, _a, x, y);
 	if (kDepthWrite && depthTestResult) {
 		pz[_a] = z;
 	}
@@ -450,6 +411,7 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				int n;
 				uint *pz;
 				byte *ps = nullptr;
+				const byte *pm = _depthSpanMask;
 				uint z;
 				n = (x2 >> 16) - x1;
 				if (kInterpZ) {
@@ -459,34 +421,56 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (kDepthTestEnabled && !kStencilEnabled) {
+					// Without stencil, a depth only span is entirely handled by the span function
+					int xStart = x1;
+					int xEnd = x1 + n + 1;
+					if (kEnableScissor) {
+						if (y < _clipRectangle.top || y >= _clipRectangle.bottom) {
+							xEnd = xStart;
+						} else {
+							xStart = MAX<int>(xStart, _clipRectangle.left);
+							xEnd = MIN<int>(xEnd, _clipRectangle.right);
+						}
+					}
+					if (kDepthWrite && xEnd > xStart) {
+						_depthSpanFunc(pz + (xStart - x1), z + (uint)dzdx * (xStart - x1), dzdx, xEnd - xStart, _depthFunc, kDepthWrite, _depthSpanMask);
+					}
+					n = -1;
+				} else if (kDepthTestEnabled && n >= 0) {
+					_depthSpanFunc(pz, z, dzdx, n + 1, _depthFunc, false, _depthSpanMask);
+				}
 				while (n >= 3) {
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 1, x, y, z, dzdx);
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 2, x, y, z, dzdx);
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 3, x, y, z, dzdx);
+					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, pm, 0, x, y, z, dzdx);
+					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, pm, 1, x, y, z, dzdx);
+					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, pm, 2, x, y, z, dzdx);
+					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, pm, 3, x, y, z, dzdx);
 					if (kInterpZ) {
 						pz += 4;
 					}
 					if (kStencilEnabled) {
 						ps += 4;
 					}
+					pm += 4;
 					n -= 4;
 					x += 4;
 				}
 				while (n >= 0) {
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
+					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, pm, 0, x, y, z, dzdx);
 					if (kInterpZ) {
 						pz += 1;
 					}
 					if (kStencilEnabled) {
 						ps += 1;
 					}
+					pm += 1;
 					n -= 1;
 					x += 1;
 				}
 			} else if (!(kInterpST || kInterpSTZ)) {
 				uint *pz;
 				byte *ps = nullptr;
+				const byte *pm = _depthSpanMask;
 				int pp;
 				uint z, r, g, b, a, fog;
 				int n = (x2 >> 16) - x1;
@@ -505,15 +489,32 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (kDepthTestEnabled && n >= 0) {
+					_depthSpanFunc(pz, z, dzdx, n + 1, _depthFunc, false, _depthSpanMask);
+				}
 				while (n >= 3) {
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 1, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 2, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 3, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					if (kDepthTestEnabled && !kStencilEnabled && READ_UINT32(pm) == 0) {
+						// Four hidden pixels in a row: only step the interpolated values
+						z += 4 * (uint)dzdx;
+						if (kFogMode) {
+							fog += 4 * (uint)dfdx;
+						}
+						if (kSmoothMode) {
+							r += 4 * (uint)drdx;
+							g += 4 * (uint)dgdx;
+							b += 4 * (uint)dbdx;
+							a += 4 * (uint)dadx;
+						}
+					} else {
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, pm, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, pm, 1, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, pm, 2, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, pm, 3, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					}
 					pp += 4;
 					if (kInterpZ) {
 						pz += 4;
@@ -521,12 +522,13 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					if (kStencilEnabled) {
 						ps += 4;
 					}
+					pm += 4;
 					n -= 4;
 					x += 4;
 				}
 				while (n >= 0) {
 					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					                 (pp, pz, ps, pm, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
 					pp += 1;
 					if (kInterpZ) {
 						pz += 1;
@@ -534,12 +536,14 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					if (kStencilEnabled) {
 						ps += 1;
 					}
+					pm += 1;
 					n -= 1;
 					x += 1;
 				}
 			} else if (kInterpST || kInterpSTZ) {
 				uint *pz;
 				byte *ps = nullptr;
+				const byte *pm = _depthSpanMask;
 				int s, t;
 				uint z, r, g, b, a, fog;
 				int n, pp;
@@ -561,6 +565,9 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (kDepthTestEnabled && n >= 0) {
+					_depthSpanFunc(pz, z, dzdx, n + 1, _depthFunc, false, _depthSpanMask);
+				}
 				sz = sz1;
 				tz = tz1;
 				r = r1;
@@ -579,9 +586,23 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						fz += fndzdx;
 						zinv = (float)(1.0 / fz);
 					}
-					for (int _a = 0; _a < NB_INTERP; _a++) {
-						putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-						               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					if (kDepthTestEnabled && !kStencilEnabled && (READ_UINT32(pm) | READ_UINT32(pm + 4)) == 0) {
+						// A whole hidden block: skip the texture lookups, only step the interpolated values
+						z += NB_INTERP * (uint)dzdx;
+						if (kFogMode) {
+							fog += NB_INTERP * (uint)dfdx;
+						}
+						if (kSmoothMode) {
+							a += NB_INTERP * (uint)dadx;
+							r += NB_INTERP * (uint)drdx;
+							g += NB_INTERP * (uint)dgdx;
+							b += NB_INTERP * (uint)dbdx;
+						}
+					} else {
+						for (int _a = 0; _a < NB_INTERP; _a++) {
+							putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+							               (pp, texture, _wrapS, _wrapT, pz, ps, pm, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						}
 					}
 					pp += NB_INTERP;
 					if (kInterpZ) {
@@ -590,6 +611,7 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					if (kStencilEnabled) {
 						ps += NB_INTERP;
 					}
+					pm += NB_INTERP;
 					sz += ndszdx;
 					tz += ndtzdx;
 					n -= NB_INTERP;
@@ -608,7 +630,7 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 
 				while (n >= 0) {
 					putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-					               (pp, texture, _wrapS, _wrapT, pz, ps, 0, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					               (pp, texture, _wrapS, _wrapT, pz, ps, pm, 0, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
 					pp += 1;
 					if (kInterpZ) {
 						pz += 1;
@@ -616,6 +638,7 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					if (kStencilEnabled) {
 						ps += 1;
 					}
+					pm += 1;
 					n -= 1;
 					x += 1;
 				}
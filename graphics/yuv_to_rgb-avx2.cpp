@@ -0,0 +1,194 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_rows.h"
+
+#include <immintrin.h>
+
+#ifdef __GNUC__
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Graphics {
+
+// See yuv_to_rgb-sse2.cpp for how these reproduce the lookup tables
+enum {
+	kCrRFrac = 26266,
+	kCrG     = 46773,
+	kCbG     = 22567,
+	kCbBFrac = 50684,
+	kITUFrac = 10776
+};
+
+static FORCEINLINE __m256i applySign(__m256i v, __m256i sign) {
+	return _mm256_sub_epi16(_mm256_xor_si256(v, sign), sign);
+}
+
+template<bool kFullScale>
+static FORCEINLINE __m256i clipChannel(__m256i v, __m128i loss) {
+	if (kFullScale) {
+		v = _mm256_min_epi16(_mm256_max_epi16(v, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+	} else {
+		v = _mm256_sub_epi16(_mm256_min_epi16(_mm256_max_epi16(v, _mm256_set1_epi16(16)), _mm256_set1_epi16(235)), _mm256_set1_epi16(16));
+		v = _mm256_add_epi16(v, _mm256_mulhi_epu16(v, _mm256_set1_epi16((int16)kITUFrac)));
+	}
+	return _mm256_srl_epi16(v, loss);
+}
+
+struct ShiftCounts {
+	__m128i rLoss, gLoss, bLoss, aLoss;
+	__m128i rShift, gShift, bShift, aShift;
+
+	ShiftCounts(const YUVToRGBRowParams &params) {
+		rLoss = _mm_cvtsi32_si128(params.rLoss);
+		gLoss = _mm_cvtsi32_si128(params.gLoss);
+		bLoss = _mm_cvtsi32_si128(params.bLoss);
+		aLoss = _mm_cvtsi32_si128(params.aLoss);
+		rShift = _mm_cvtsi32_si128(params.rShift);
+		gShift = _mm_cvtsi32_si128(params.gShift);
+		bShift = _mm_cvtsi32_si128(params.bShift);
+		aShift = _mm_cvtsi32_si128(params.aShift);
+	}
+};
+
+static FORCEINLINE __m256i load16(const byte *src) {
+	return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)src));
+}
+
+// Computes the red, green and blue offsets for 16 chroma samples
+static FORCEINLINE void chromaOffsets(const byte *uSrc, const byte *vSrc, __m256i &dR, __m256i &dG, __m256i &dB) {
+	const __m256i cr = _mm256_sub_epi16(load16(vSrc), _mm256_set1_epi16(128));
+	const __m256i cb = _mm256_sub_epi16(load16(uSrc), _mm256_set1_epi16(128));
+	const __m256i crSign = _mm256_srai_epi16(cr, 15);
+	const __m256i cbSign = _mm256_srai_epi16(cb, 15);
+	const __m256i crAbs = _mm256_abs_epi16(cr);
+	const __m256i cbAbs = _mm256_abs_epi16(cb);
+
+	dR = applySign(_mm256_add_epi16(crAbs, _mm256_mulhi_epu16(crAbs, _mm256_set1_epi16((int16)kCrRFrac))), crSign);
+	dB = applySign(_mm256_add_epi16(cbAbs, _mm256_mulhi_epu16(cbAbs, _mm256_set1_epi16((int16)kCbBFrac))), cbSign);
+	dG = _mm256_sub_epi16(_mm256_sub_epi16(_mm256_setzero_si256(),
+		applySign(_mm256_mulhi_epu16(crAbs, _mm256_set1_epi16((int16)kCrG)), crSign)),
+		applySign(_mm256_mulhi_epu16(cbAbs, _mm256_set1_epi16((int16)kCbG)), cbSign));
+}
+
+// Converts and stores 16 pixels
+template<bool kAlpha, bool kFullScale, typename PixelInt>
+static FORCEINLINE void storePixels(byte *dst, const byte *ySrc, const byte *aSrc, __m256i dR, __m256i dG, __m256i dB, const ShiftCounts &counts, uint32 aMask) {
+	const __m256i y = load16(ySrc);
+
+	const __m256i r = clipChannel<kFullScale>(_mm256_add_epi16(y, dR), counts.rLoss);
+	const __m256i g = clipChannel<kFullScale>(_mm256_add_epi16(y, dG), counts.gLoss);
+	const __m256i b = clipChannel<kFullScale>(_mm256_add_epi16(y, dB), counts.bLoss);
+
+	__m256i a = _mm256_setzero_si256();
+	if (kAlpha)
+		a = _mm256_srl_epi16(load16(aSrc), counts.aLoss);
+
+	if (sizeof(PixelInt) == 2) {
+		__m256i pixels = _mm256_or_si256(_mm256_or_si256(_mm256_sll_epi16(r, counts.rShift), _mm256_sll_epi16(g, counts.gShift)), _mm256_sll_epi16(b, counts.bShift));
+		pixels = _mm256_or_si256(pixels, kAlpha ? _mm256_sll_epi16(a, counts.aShift) : _mm256_set1_epi16((int16)aMask));
+		_mm256_storeu_si256((__m256i *)dst, pixels);
+	} else {
+		// Widen each 128 bit half separately so the pixels stay in order
+		for (int half = 0; half < 2; half++) {
+			__m256i r32 = _mm256_cvtepu16_epi32(half ? _mm256_extracti128_si256(r, 1) : _mm256_castsi256_si128(r));
+			__m256i g32 = _mm256_cvtepu16_epi32(half ? _mm256_extracti128_si256(g, 1) : _mm256_castsi256_si128(g));
+			__m256i b32 = _mm256_cvtepu16_epi32(half ? _mm256_extracti128_si256(b, 1) : _mm256_castsi256_si128(b));
+			__m256i pixels = _mm256_or_si256(_mm256_or_si256(_mm256_sll_epi32(r32, counts.rShift), _mm256_sll_epi32(g32, counts.gShift)), _mm256_sll_epi32(b32, counts.bShift));
+			if (kAlpha)
+				pixels = _mm256_or_si256(pixels, _mm256_sll_epi32(_mm256_cvtepu16_epi32(half ? _mm256_extracti128_si256(a, 1) : _mm256_castsi256_si128(a)), counts.aShift));
+			else
+				pixels = _mm256_or_si256(pixels, _mm256_set1_epi32((int32)aMask));
+			_mm256_storeu_si256((__m256i *)(dst + half * 32), pixels);
+		}
+	}
+}
+
+// Duplicates each 16-bit value; lo gets the first 8, hi the last 8
+static FORCEINLINE void duplicate(__m256i v, __m256i &lo, __m256i &hi) {
+	v = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 1, 2, 0));
+	lo = _mm256_unpacklo_epi16(v, v);
+	hi = _mm256_unpackhi_epi16(v, v);
+}
+
+template<bool kHalfChroma, bool kAlpha, bool kFullScale, typename PixelInt>
+static void convertRow(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowParams &params) {
+	const ShiftCounts counts(params);
+	__m256i dR, dG, dB;
+
+	int w = 0;
+	if (kHalfChroma) {
+		// Each chroma sample covers two pixels, so 16 samples make 32 pixels
+		for (; w + 32 <= width; w += 32) {
+			__m256i dRLo, dRHi, dGLo, dGHi, dBLo, dBHi;
+			chromaOffsets(uSrc + w / 2, vSrc + w / 2, dR, dG, dB);
+			duplicate(dR, dRLo, dRHi);
+			duplicate(dG, dGLo, dGHi);
+			duplicate(dB, dBLo, dBHi);
+			storePixels<kAlpha, kFullScale, PixelInt>(dst + w * sizeof(PixelInt), ySrc + w, kAlpha ? aSrc + w : nullptr,
+				dRLo, dGLo, dBLo, counts, params.aMask);
+			storePixels<kAlpha, kFullScale, PixelInt>(dst + (w + 16) * sizeof(PixelInt), ySrc + w + 16, kAlpha ? aSrc + w + 16 : nullptr,
+				dRHi, dGHi, dBHi, counts, params.aMask);
+		}
+	} else {
+		for (; w + 16 <= width; w += 16) {
+			chromaOffsets(uSrc + w, vSrc + w, dR, dG, dB);
+			storePixels<kAlpha, kFullScale, PixelInt>(dst + w * sizeof(PixelInt), ySrc + w, kAlpha ? aSrc + w : nullptr, dR, dG, dB, counts, params.aMask);
+		}
+	}
+
+	if (w < width) {
+		int uvOffset = kHalfChroma ? w / 2 : w;
+		convertYUVToRGBRowGeneric(dst + w * sizeof(PixelInt), ySrc + w, uSrc + uvOffset, vSrc + uvOffset, kAlpha ? aSrc + w : nullptr,
+		                          width - w, kHalfChroma, sizeof(PixelInt) == 4, params);
+	}
+}
+
+template<bool kHalfChroma, typename PixelInt>
+static void convertRowAVX2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowParams &params) {
+	if (aSrc) {
+		if (params.fullScale)
+			convertRow<kHalfChroma, true, true, PixelInt>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+		else
+			convertRow<kHalfChroma, true, false, PixelInt>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+	} else {
+		if (params.fullScale)
+			convertRow<kHalfChroma, false, true, PixelInt>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+		else
+			convertRow<kHalfChroma, false, false, PixelInt>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+	}
+}
+
+void initYUVToRGBRowsAVX2(YUVToRGBRowFuncs &funcs) {
+	funcs.full16 = convertRowAVX2<false, uint16>;
+	funcs.full32 = convertRowAVX2<false, uint32>;
+	funcs.half16 = convertRowAVX2<true, uint16>;
+	funcs.half32 = convertRowAVX2<true, uint32>;
+}
+
+} // End of namespace Graphics
+
+#ifdef __GNUC__
+#pragma GCC pop_options
+#endif
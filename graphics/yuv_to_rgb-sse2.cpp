@@ -0,0 +1,188 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_rows.h"
+
+#include <emmintrin.h>
+
+#ifdef __GNUC__
+#pragma GCC push_options
+
+#ifndef __x86_64__
+#pragma GCC target("sse2")
+#endif
+
+#endif
+
+namespace Graphics {
+
+// These reproduce the lookup tables exactly: trunc(k * c) is computed on |c|
+// as |c| * k in 0.16 fixed point, the multipliers were checked for every c.
+enum {
+	kCrRFrac = 26266, // 1 + 0.4013...
+	kCrG     = 46773, // 0.7136...
+	kCbG     = 22567, // 0.3444...
+	kCbBFrac = 50684, // 1 + 0.7734...
+	kITUFrac = 10776  // 255 / 219 = 1 + 0.1644...
+};
+
+static FORCEINLINE __m128i applySign(__m128i v, __m128i sign) {
+	return _mm_sub_epi16(_mm_xor_si128(v, sign), sign);
+}
+
+template<bool kFullScale>
+static FORCEINLINE __m128i clipChannel(__m128i v, __m128i loss) {
+	if (kFullScale) {
+		v = _mm_min_epi16(_mm_max_epi16(v, _mm_setzero_si128()), _mm_set1_epi16(255));
+	} else {
+		v = _mm_sub_epi16(_mm_min_epi16(_mm_max_epi16(v, _mm_set1_epi16(16)), _mm_set1_epi16(235)), _mm_set1_epi16(16));
+		v = _mm_add_epi16(v, _mm_mulhi_epu16(v, _mm_set1_epi16((int16)kITUFrac)));
+	}
+	return _mm_srl_epi16(v, loss);
+}
+
+struct ShiftCounts {
+	__m128i rLoss, gLoss, bLoss, aLoss;
+	__m128i rShift, gShift, bShift, aShift;
+
+	ShiftCounts(const YUVToRGBRowParams &params) {
+		rLoss = _mm_cvtsi32_si128(params.rLoss);
+		gLoss = _mm_cvtsi32_si128(params.gLoss);
+		bLoss = _mm_cvtsi32_si128(params.bLoss);
+		aLoss = _mm_cvtsi32_si128(params.aLoss);
+		rShift = _mm_cvtsi32_si128(params.rShift);
+		gShift = _mm_cvtsi32_si128(params.gShift);
+		bShift = _mm_cvtsi32_si128(params.bShift);
+		aShift = _mm_cvtsi32_si128(params.aShift);
+	}
+};
+
+// Computes the red, green and blue offsets for 8 chroma samples
+static FORCEINLINE void chromaOffsets(const byte *uSrc, const byte *vSrc, __m128i &dR, __m128i &dG, __m128i &dB) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i u = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)uSrc), zero);
+	const __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)vSrc), zero);
+
+	const __m128i cr = _mm_sub_epi16(v, _mm_set1_epi16(128));
+	const __m128i cb = _mm_sub_epi16(u, _mm_set1_epi16(128));
+	const __m128i crSign = _mm_srai_epi16(cr, 15);
+	const __m128i cbSign = _mm_srai_epi16(cb, 15);
+	const __m128i crAbs = applySign(cr, crSign);
+	const __m128i cbAbs = applySign(cb, cbSign);
+
+	dR = applySign(_mm_add_epi16(crAbs, _mm_mulhi_epu16(crAbs, _mm_set1_epi16((int16)kCrRFrac))), crSign);
+	dB = applySign(_mm_add_epi16(cbAbs, _mm_mulhi_epu16(cbAbs, _mm_set1_epi16((int16)kCbBFrac))), cbSign);
+	dG = _mm_sub_epi16(_mm_sub_epi16(zero,
+		applySign(_mm_mulhi_epu16(crAbs, _mm_set1_epi16((int16)kCrG)), crSign)),
+		applySign(_mm_mulhi_epu16(cbAbs, _mm_set1_epi16((int16)kCbG)), cbSign));
+}
+
+// Converts and stores 8 pixels
+template<bool kAlpha, bool kFullScale, typename PixelInt>
+static FORCEINLINE void storePixels(byte *dst, const byte *ySrc, const byte *aSrc, __m128i dR, __m128i dG, __m128i dB, const ShiftCounts &counts, uint32 aMask) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)ySrc), zero);
+
+	const __m128i r = clipChannel<kFullScale>(_mm_add_epi16(y, dR), counts.rLoss);
+	const __m128i g = clipChannel<kFullScale>(_mm_add_epi16(y, dG), counts.gLoss);
+	const __m128i b = clipChannel<kFullScale>(_mm_add_epi16(y, dB), counts.bLoss);
+
+	__m128i a = zero;
+	if (kAlpha)
+		a = _mm_srl_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)aSrc), zero), counts.aLoss);
+
+	if (sizeof(PixelInt) == 2) {
+		__m128i pixels = _mm_or_si128(_mm_or_si128(_mm_sll_epi16(r, counts.rShift), _mm_sll_epi16(g, counts.gShift)), _mm_sll_epi16(b, counts.bShift));
+		pixels = _mm_or_si128(pixels, kAlpha ? _mm_sll_epi16(a, counts.aShift) : _mm_set1_epi16((int16)aMask));
+		_mm_storeu_si128((__m128i *)dst, pixels);
+	} else {
+		__m128i lo = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, zero), counts.rShift), _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), counts.gShift)), _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), counts.bShift));
+		__m128i hi = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, zero), counts.rShift), _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), counts.gShift)), _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), counts.bShift));
+		if (kAlpha) {
+			lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(a, zero), counts.aShift));
+			hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(a, zero), counts.aShift));
+		} else {
+			lo = _mm_or_si128(lo, _mm_set1_epi32((int32)aMask));
+			hi = _mm_or_si128(hi, _mm_set1_epi32((int32)aMask));
+		}
+		_mm_storeu_si128((__m128i *)dst, lo);
+		_mm_storeu_si128((__m128i *)(dst + 16), hi);
+	}
+}
+
+template<bool kHalfChroma, bool kAlpha, bool kFullScale, typename PixelInt>
+static void convertRow(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowParams &params) {
+	const ShiftCounts counts(params);
+	__m128i dR, dG, dB;
+
+	int w = 0;
+	if (kHalfChroma) {
+		// Each chroma sample covers two pixels, so 8 samples make 16 pixels
+		for (; w + 16 <= width; w += 16) {
+			chromaOffsets(uSrc + w / 2, vSrc + w / 2, dR, dG, dB);
+			storePixels<kAlpha, kFullScale, PixelInt>(dst + w * sizeof(PixelInt), ySrc + w, kAlpha ? aSrc + w : nullptr,
+				_mm_unpacklo_epi16(dR, dR), _mm_unpacklo_epi16(dG, dG), _mm_unpacklo_epi16(dB, dB), counts, params.aMask);
+			storePixels<kAlpha, kFullScale, PixelInt>(dst + (w + 8) * sizeof(PixelInt), ySrc + w + 8, kAlpha ? aSrc + w + 8 : nullptr,
+				_mm_unpackhi_epi16(dR, dR), _mm_unpackhi_epi16(dG, dG), _mm_unpackhi_epi16(dB, dB), counts, params.aMask);
+		}
+	} else {
+		for (; w + 8 <= width; w += 8) {
+			chromaOffsets(uSrc + w, vSrc + w, dR, dG, dB);
+			storePixels<kAlpha, kFullScale, PixelInt>(dst + w * sizeof(PixelInt), ySrc + w, kAlpha ? aSrc + w : nullptr, dR, dG, dB, counts, params.aMask);
+		}
+	}
+
+	if (w < width) {
+		int uvOffset = kHalfChroma ? w / 2 : w;
+		convertYUVToRGBRowGeneric(dst + w * sizeof(PixelInt), ySrc + w, uSrc + uvOffset, vSrc + uvOffset, kAlpha ? aSrc + w : nullptr,
+		                          width - w, kHalfChroma, sizeof(PixelInt) == 4, params);
+	}
+}
+
+template<bool kHalfChroma, typename PixelInt>
+static void convertRowSSE2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowParams &params) {
+	if (aSrc) {
+		if (params.fullScale)
+			convertRow<kHalfChroma, true, true, PixelInt>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+		else
+			convertRow<kHalfChroma, true, false, PixelInt>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+	} else {
+		if (params.fullScale)
+			convertRow<kHalfChroma, false, true, PixelInt>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+		else
+			convertRow<kHalfChroma, false, false, PixelInt>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+	}
+}
+
+void initYUVToRGBRowsSSE2(YUVToRGBRowFuncs &funcs) {
+	funcs.full16 = convertRowSSE2<false, uint16>;
+	funcs.full32 = convertRowSSE2<false, uint32>;
+	funcs.half16 = convertRowSSE2<true, uint16>;
+	funcs.half32 = convertRowSSE2<true, uint32>;
+}
+
+} // End of namespace Graphics
+
+#ifdef __GNUC__
+#pragma GCC pop_options
+#endif
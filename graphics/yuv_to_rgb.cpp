@@ -82,8 +82,10 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/system.h"
+
 #include "graphics/surface.h"
-#include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_rows.h"
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
@@ -91,22 +93,6 @@ DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 
 namespace Graphics {
 
-class YUVToRGBLookup {
-public:
-	YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale);
-
-	Graphics::PixelFormat getFormat() const { return _format; }
-	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
-	const int16 *getColorTable() const { return _colorTab; }
-	const byte *getClipTable() const { return _clipTable; }
-
-private:
-	Graphics::PixelFormat _format;
-	YUVToRGBManager::LuminanceScale _scale;
-	int16 _colorTab[4 * 256]; // 2048 bytes
-	byte _clipTable[3 * 768];
-};
-
 YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
 	_format = format;
 	_scale = scale;
@@ -179,14 +165,30 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 		Cb_g_tab[i] = (int16) (-(0.114 / 0.331) * CB);
 		Cb_b_tab[i] = (int16) ( (0.587 / 0.331) * CB) + b_offset + 256;
 	}
+
+	_rowParams.colorTab = _colorTab;
+	_rowParams.clipTable = _clipTable;
+	_rowParams.fullScale = (scale == YUVToRGBManager::kScaleFull);
+	_rowParams.rLoss = format.rLoss;
+	_rowParams.gLoss = format.gLoss;
+	_rowParams.bLoss = format.bLoss;
+	_rowParams.aLoss = format.aLoss;
+	_rowParams.rShift = format.rShift;
+	_rowParams.gShift = format.gShift;
+	_rowParams.bShift = format.bShift;
+	_rowParams.aShift = format.aShift;
+	_rowParams.aMask = (0xFF >> format.aLoss) << format.aShift;
 }
 
 YUVToRGBManager::YUVToRGBManager() {
 	_lookup = 0;
+	_rowFuncs = new YUVToRGBRowFuncs();
+	initYUVToRGBRows(*_rowFuncs);
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
 	delete _lookup;
+	delete _rowFuncs;
 }
 
 const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
@@ -198,231 +200,138 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
-#define PUT_PIXEL(s, d) \
+#define PUT_PIXEL(s, a, d) \
 	L = &clipTable[(s)]; \
-	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | a_mask)
+	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | (a))
 
-template<typename PixelInt>
-void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+template<typename PixelInt, bool kHalfChroma, bool kAlpha>
+static void convertYUVToRGBRow(byte *dstPtr, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowParams &params) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = lookup->getColorTable();
+	const int16 *Cr_r_tab = params.colorTab;
 	const int16 *Cr_g_tab = Cr_r_tab + 256;
 	const int16 *Cb_g_tab = Cr_g_tab + 256;
 	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const byte *clipTable = lookup->getClipTable();
-
-	const byte r_shift = lookup->getFormat().rShift;
-	const byte g_shift = lookup->getFormat().gShift;
-	const byte b_shift = lookup->getFormat().bShift;
-	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
-
-	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < yWidth; w++) {
-			const byte *L;
-
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
-
-			PUT_PIXEL(*ySrc, dstPtr);
+	const byte *clipTable = params.clipTable;
+
+	const byte r_shift = params.rShift;
+	const byte g_shift = params.gShift;
+	const byte b_shift = params.bShift;
+	const byte a_shift = params.aShift;
+	const byte a_loss = params.aLoss;
+	const PixelInt a_mask = params.aMask;
+
+	for (int w = 0; w < width; w += (kHalfChroma ? 2 : 1)) {
+		const byte *L;
+
+		int16 cr_r  = Cr_r_tab[*vSrc];
+		int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
+		int16 cb_b  = Cb_b_tab[*uSrc];
+		++uSrc;
+		++vSrc;
+
+		PUT_PIXEL(*ySrc, kAlpha ? (PixelInt)((*aSrc++ >> a_loss) << a_shift) : a_mask, dstPtr);
+		ySrc++;
+		dstPtr += sizeof(PixelInt);
+
+		if (kHalfChroma) {
+			PUT_PIXEL(*ySrc, kAlpha ? (PixelInt)((*aSrc++ >> a_loss) << a_shift) : a_mask, dstPtr);
 			ySrc++;
 			dstPtr += sizeof(PixelInt);
 		}
-
-		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
-		ySrc += yPitch - yWidth;
-		uSrc += uvPitch - yWidth;
-		vSrc += uvPitch - yWidth;
 	}
 }
 
-void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Sanity checks
-	assert(dst && dst->getPixels());
-	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
-	assert(ySrc && uSrc && vSrc);
-
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+#undef PUT_PIXEL
 
+template<typename PixelInt, bool kHalfChroma>
+static void convertYUVToRGBRow(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowParams &params) {
 	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	if (aSrc)
+		convertYUVToRGBRow<PixelInt, kHalfChroma, true>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
 	else
-		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVToRGBRow<PixelInt, kHalfChroma, false>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
 }
 
-template<typename PixelInt>
-void convertYUV422ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	int halfWidth = yWidth >> 1;
-
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = lookup->getColorTable();
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const byte *clipTable = lookup->getClipTable();
-
-	const byte r_shift = lookup->getFormat().rShift;
-	const byte g_shift = lookup->getFormat().gShift;
-	const byte b_shift = lookup->getFormat().bShift;
-	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
-
-	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
-			const byte *L;
-
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
+void convertYUVToRGBRowGeneric(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma, bool is32Bit, const YUVToRGBRowParams &params) {
+	if (is32Bit) {
+		if (halfChroma)
+			convertYUVToRGBRow<uint32, true>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+		else
+			convertYUVToRGBRow<uint32, false>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+	} else {
+		if (halfChroma)
+			convertYUVToRGBRow<uint16, true>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+		else
+			convertYUVToRGBRow<uint16, false>(dst, ySrc, uSrc, vSrc, aSrc, width, params);
+	}
+}
 
-			PUT_PIXEL(*ySrc, dstPtr);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-			PUT_PIXEL(*ySrc, dstPtr);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-		}
+void initYUVToRGBRowsGeneric(YUVToRGBRowFuncs &funcs) {
+	funcs.full16 = convertYUVToRGBRow<uint16, false>;
+	funcs.full32 = convertYUVToRGBRow<uint32, false>;
+	funcs.half16 = convertYUVToRGBRow<uint16, true>;
+	funcs.half32 = convertYUVToRGBRow<uint32, true>;
+}
 
-		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
-		ySrc += yPitch  - yWidth;
-		uSrc += uvPitch - halfWidth;
-		vSrc += uvPitch - halfWidth;
-	}
+void initYUVToRGBRows(YUVToRGBRowFuncs &funcs) {
+	initYUVToRGBRowsGeneric(funcs);
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		initYUVToRGBRowsSSE2(funcs);
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+		initYUVToRGBRowsAVX2(funcs);
+#endif
 }
 
-void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
-	assert((yWidth & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const YUVToRGBRowParams &params = lookup->getRowParams();
+	YUVToRGBRowFunc convertRow = (dst->format.bytesPerPixel == 2) ? _rowFuncs->full16 : _rowFuncs->full32;
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV422ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-}
-
-template<typename PixelInt>
-void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	int halfHeight = yHeight >> 1;
-	int halfWidth = yWidth >> 1;
-
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = lookup->getColorTable();
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const byte *clipTable = lookup->getClipTable();
-
-	const byte r_shift = lookup->getFormat().rShift;
-	const byte g_shift = lookup->getFormat().gShift;
-	const byte b_shift = lookup->getFormat().bShift;
-	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
-
-	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
-			const byte *L;
-
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
-
-			PUT_PIXEL(*ySrc, dstPtr);
-			PUT_PIXEL(*(ySrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-			PUT_PIXEL(*ySrc, dstPtr);
-			PUT_PIXEL(*(ySrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-		}
+	byte *dstPtr = (byte *)dst->getPixels();
+	for (int h = 0; h < yHeight; h++) {
+		convertRow(dstPtr, ySrc, uSrc, vSrc, nullptr, yWidth, params);
 
-		dstPtr += dstPitch;
-		ySrc += (yPitch << 1) - yWidth;
-		uSrc += uvPitch - halfWidth;
-		vSrc += uvPitch - halfWidth;
+		dstPtr += dst->pitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
 	}
 }
 
-void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
 	assert((yWidth & 1) == 0);
-	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const YUVToRGBRowParams &params = lookup->getRowParams();
+	YUVToRGBRowFunc convertRow = (dst->format.bytesPerPixel == 2) ? _rowFuncs->half16 : _rowFuncs->half32;
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-}
-
-#define PUT_PIXELA(s, a, d) \
-	L = &clipTable[(s)]; \
-	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | ((a >> a_loss) << a_shift))
-
-template<typename PixelInt>
-void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	int halfHeight = yHeight >> 1;
-	int halfWidth = yWidth >> 1;
-
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = lookup->getColorTable();
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const byte *clipTable = lookup->getClipTable();
-
-	const byte r_shift = lookup->getFormat().rShift;
-	const byte g_shift = lookup->getFormat().gShift;
-	const byte b_shift = lookup->getFormat().bShift;
-	const byte a_shift = lookup->getFormat().aShift;
-	const byte a_loss = lookup->getFormat().aLoss;
-
-	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
-			const byte *L;
-
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
-
-			PUT_PIXELA(*ySrc, *aSrc, dstPtr);
-			PUT_PIXELA(*(ySrc + yPitch), *(aSrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			aSrc++;
-			dstPtr += sizeof(PixelInt);
-			PUT_PIXELA(*ySrc, *aSrc, dstPtr);
-			PUT_PIXELA(*(ySrc + yPitch), *(aSrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			aSrc++;
-			dstPtr += sizeof(PixelInt);
-		}
+	byte *dstPtr = (byte *)dst->getPixels();
+	for (int h = 0; h < yHeight; h++) {
+		convertRow(dstPtr, ySrc, uSrc, vSrc, nullptr, yWidth, params);
 
-		dstPtr += dstPitch;
-		ySrc += (yPitch << 1) - yWidth;
-		aSrc += (yPitch << 1) - yWidth;
-		uSrc += uvPitch - halfWidth;
-		vSrc += uvPitch - halfWidth;
+		dstPtr += dst->pitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
 	}
 }
 
+void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	convert420Alpha(dst, scale, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch);
+}
+
 void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
@@ -432,12 +341,24 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const YUVToRGBRowParams &params = lookup->getRowParams();
+	YUVToRGBRowFunc convertRow = (dst->format.bytesPerPixel == 2) ? _rowFuncs->half16 : _rowFuncs->half32;
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+	byte *dstPtr = (byte *)dst->getPixels();
+	for (int h = 0; h < yHeight; h++) {
+		convertRow(dstPtr, ySrc, uSrc, vSrc, aSrc, yWidth, params);
+
+		dstPtr += dst->pitch;
+		ySrc += yPitch;
+		if (aSrc)
+			aSrc += yPitch;
+
+		// Each chroma row is shared by two luma rows
+		if (h & 1) {
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+	}
 }
 
 #define READ_QUAD(ptr, prefix) \
@@ -450,84 +371,55 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	out = (out##A * (4 - xDiff) * (4 - yDiff) + out##B * xDiff * (4 - yDiff) + \
 			out##C * yDiff * (4 - xDiff) + out##D * xDiff * yDiff) >> 4
 
-#define DO_YUV410_PIXEL() \
-	DO_INTERPOLATION(u); \
-	DO_INTERPOLATION(v); \
-	\
-	cr_r  = Cr_r_tab[v]; \
-	crb_g = Cr_g_tab[v] + Cb_g_tab[u]; \
-	cb_b  = Cb_b_tab[u]; \
-	\
-	PUT_PIXEL(*ySrc, dstPtr); \
-	dstPtr += sizeof(PixelInt); \
-	\
-	ySrc++; \
-	xDiff++
-
-template<typename PixelInt>
-void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = lookup->getColorTable();
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const byte *clipTable = lookup->getClipTable();
+void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	// Sanity checks
+	assert(dst && dst->getPixels());
+	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
+	assert(ySrc && uSrc && vSrc);
+	assert((yWidth & 3) == 0);
+	assert((yHeight & 3) == 0);
 
-	const byte r_shift = lookup->getFormat().rShift;
-	const byte g_shift = lookup->getFormat().gShift;
-	const byte b_shift = lookup->getFormat().bShift;
-	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
+	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const YUVToRGBRowParams &params = lookup->getRowParams();
+	YUVToRGBRowFunc convertRow = (dst->format.bytesPerPixel == 2) ? _rowFuncs->full16 : _rowFuncs->full32;
+
+	// The chroma of each row is upsampled first, then converted like 444
+	if (_uRow.size() < (uint)yWidth) {
+		_uRow.resize(yWidth);
+		_vRow.resize(yWidth);
+	}
 
 	int quarterWidth = yWidth >> 2;
 
+	byte *dstPtr = (byte *)dst->getPixels();
 	for (int y = 0; y < yHeight; y++) {
 		for (int x = 0; x < quarterWidth; x++) {
 			// Perform bilinear interpolation on the chroma values
 			// Based on the algorithm found here: http://tech-algorithm.com/articles/bilinear-image-scaling/
-			// Feel free to optimize further
 			int targetY = y >> 2;
-			int xDiff = 0;
 			int yDiff = y & 3;
 			int index = targetY * uvPitch + x;
 
-			// Declare some variables for the following macros
-			byte u, v;
-			int16 cr_r, crb_g, cb_b;
-			const byte *L;
-
 			READ_QUAD(uSrc, u);
 			READ_QUAD(vSrc, v);
 
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
+			for (int xDiff = 0; xDiff < 4; xDiff++) {
+				byte u, v;
+				DO_INTERPOLATION(u);
+				DO_INTERPOLATION(v);
+				_uRow[x * 4 + xDiff] = u;
+				_vRow[x * 4 + xDiff] = v;
+			}
 		}
 
-		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
-		ySrc += yPitch - yWidth;
+		convertRow(dstPtr, ySrc, _uRow.data(), _vRow.data(), nullptr, yWidth, params);
+
+		dstPtr += dst->pitch;
+		ySrc += yPitch;
 	}
 }
 
 #undef READ_QUAD
 #undef DO_INTERPOLATION
-#undef DO_YUV410_PIXEL
-
-void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Sanity checks
-	assert(dst && dst->getPixels());
-	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
-	assert(ySrc && uSrc && vSrc);
-	assert((yWidth & 3) == 0);
-	assert((yHeight & 3) == 0);
-
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
-
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV410ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-}
 
 } // End of namespace Graphics
@@ -38,12 +38,14 @@
 #define GRAPHICS_YUV_TO_RGB_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/singleton.h"
 #include "graphics/surface.h"
 
 namespace Graphics {
 
 class YUVToRGBLookup;
+struct YUVToRGBRowFuncs;
 
 class YUVToRGBManager : public Common::Singleton<YUVToRGBManager> {
 public:
@@ -143,6 +145,10 @@ private:
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
 
 	YUVToRGBLookup *_lookup;
+	YUVToRGBRowFuncs *_rowFuncs;
+
+	/** Upsampled chroma of the current row, kept between frames by convert410() */
+	Common::Array<byte> _uRow, _vRow;
 };
  /** @} */
 } // End of namespace Graphics
@@ -0,0 +1,98 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_YUV_TO_RGB_ROWS_H
+#define GRAPHICS_YUV_TO_RGB_ROWS_H
+
+#include "common/scummsys.h"
+
+#include "graphics/pixelformat.h"
+#include "graphics/yuv_to_rgb.h"
+
+namespace Graphics {
+
+/**
+ * Everything a row converter needs to know about the destination format.
+ * The tables are the ones built by YUVToRGBLookup; the SIMD converters
+ * compute the same values arithmetically.
+ */
+struct YUVToRGBRowParams {
+	const int16 *colorTab;
+	const byte *clipTable;
+	bool fullScale;
+	byte rLoss, gLoss, bLoss, aLoss;
+	byte rShift, gShift, bShift, aShift;
+	uint32 aMask;
+};
+
+/**
+ * Converts one row of width pixels. uSrc and vSrc hold either one sample per
+ * pixel or, for the half variants, one sample per two pixels (width must then
+ * be even). aSrc may be nullptr, in which case the pixels are fully opaque.
+ */
+typedef void (*YUVToRGBRowFunc)(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowParams &params);
+
+struct YUVToRGBRowFuncs {
+	YUVToRGBRowFunc full16;
+	YUVToRGBRowFunc full32;
+	YUVToRGBRowFunc half16;
+	YUVToRGBRowFunc half32;
+};
+
+/** The table based converter, also used by the SIMD ones for the last pixels of a row. */
+void convertYUVToRGBRowGeneric(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma, bool is32Bit, const YUVToRGBRowParams &params);
+
+void initYUVToRGBRowsGeneric(YUVToRGBRowFuncs &funcs);
+#ifdef SCUMMVM_SSE2
+void initYUVToRGBRowsSSE2(YUVToRGBRowFuncs &funcs);
+#endif
+#ifdef SCUMMVM_AVX2
+void initYUVToRGBRowsAVX2(YUVToRGBRowFuncs &funcs);
+#endif
+
+/** Fill in the fastest row converters supported by the running CPU. */
+void initYUVToRGBRows(YUVToRGBRowFuncs &funcs);
+
+/**
+ * The lookup tables for one destination format and luminance scale, and the
+ * matching parameters for the row converters.
+ */
+class YUVToRGBLookup {
+public:
+	YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale);
+
+	Graphics::PixelFormat getFormat() const { return _format; }
+	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
+	const int16 *getColorTable() const { return _colorTab; }
+	const byte *getClipTable() const { return _clipTable; }
+	const YUVToRGBRowParams &getRowParams() const { return _rowParams; }
+
+private:
+	Graphics::PixelFormat _format;
+	YUVToRGBManager::LuminanceScale _scale;
+	int16 _colorTab[4 * 256]; // 2048 bytes
+	byte _clipTable[3 * 768];
+	YUVToRGBRowParams _rowParams;
+};
+
+} // End of namespace Graphics
+
+#endif
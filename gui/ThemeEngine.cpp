@@ -21,6 +21,7 @@
 
 #include "common/system.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/compression/unzip.h"
@@ -85,6 +86,12 @@ struct WidgetDrawData {
 
 	DrawLayer _layer;
 
+	/** Whether the result of the draw steps may be kept in the render cache */
+	bool _cacheable;
+
+	/** Whether the draw steps use colors which they do not set themselves */
+	bool _inheritsColors;
+
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -94,8 +101,185 @@ struct WidgetDrawData {
 	 * value will be added when restoring the background of the widget.
 	 */
 	void calcBackgroundOffset();
+
+	/**
+	 * Calculates whether the DrawData item can be drawn from the render cache.
+	 * Like calcBackgroundOffset() it must be called after loading all the
+	 * DrawSteps of the item.
+	 */
+	void calcCacheability();
+};
+
+/**
+ * Cache of drawn DrawData items.
+ *
+ * Drawing a DrawData item rasterizes its vector steps, which is costly for
+ * rounded corners, gradients, bevels and shadows. As the steps blend with
+ * what is already on the surface, an entry for an item drawn at a given
+ * position stores the pixels found there beforehand along with the final
+ * ones. It is only used when the surface still holds the same pixels there:
+ * comparing them costs about as much as copying the result, where hashing
+ * them costs as much as drawing the item.
+ */
+class ThemeRenderCache {
+public:
+	struct Key {
+		uint32 state;       ///< VectorRenderer::getStateHash(), when used
+		uint32 dynamic;
+		int16 x, y;         ///< Position of the drawing area
+		int16 width, height;
+		int16 left, top, right, bottom; ///< Cached area, relative to the drawing area
+		int type;
+
+		bool operator==(const Key &other) const {
+			return state == other.state && dynamic == other.dynamic && x == other.x && y == other.y &&
+				width == other.width && height == other.height && left == other.left && top == other.top &&
+				right == other.right && bottom == other.bottom && type == other.type;
+		}
+	};
+
+	enum {
+		kBudget = 4 * 1024 * 1024,  ///< Bytes of pixel data kept at most
+		kMaxArea = 256 * 256        ///< Pixels of the largest area cached
+	};
+
+	ThemeRenderCache() : _usedBytes(0), _tick(0), _hits(0), _misses(0), _evictions(0),
+		_loggedHits(0), _loggedMisses(0), _loggedEvictions(0) {
+	}
+
+	~ThemeRenderCache() {
+		clear();
+	}
+
+	void clear();
+
+	/**
+	 * Return the drawn pixels of an item, if the area r of dst still holds
+	 * the pixels the item was drawn over.
+	 */
+	const Graphics::Surface *find(const Key &key, const Graphics::ManagedSurface &dst, const Common::Rect &r);
+
+	/**
+	 * Store the pixels in the area r of src before the item is drawn, and
+	 * return the surface which receives the drawn pixels afterwards.
+	 */
+	Graphics::Surface *add(const Key &key, const Graphics::ManagedSurface &src, const Common::Rect &r);
+
+	/**
+	 * Log the counters on the GUI debug channel, if they changed since the
+	 * last call.
+	 */
+	void logStats();
+
+private:
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			uint hash = key.state;
+			hash = hash * 31 + key.dynamic;
+			hash = hash * 31 + (key.x << 16 | (uint16)key.y);
+			hash = hash * 31 + (key.width << 16 | (uint16)key.height);
+			return hash * 31 + key.type;
+		}
+	};
+
+	struct Entry {
+		Graphics::Surface background;
+		Graphics::Surface image;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+	EntryMap _entries;
+	uint32 _usedBytes;
+	uint32 _tick;
+
+	uint32 _hits;      ///< Items copied from the cache
+	uint32 _misses;    ///< Cacheable items which had to be drawn
+	uint32 _evictions; ///< Items dropped to stay within the cache budget
+	uint32 _loggedHits, _loggedMisses, _loggedEvictions;
 };
 
+void ThemeRenderCache::clear() {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		i->_value.background.free();
+		i->_value.image.free();
+	}
+
+	_entries.clear();
+	_usedBytes = 0;
+}
+
+const Graphics::Surface *ThemeRenderCache::find(const Key &key, const Graphics::ManagedSurface &dst, const Common::Rect &r) {
+	EntryMap::iterator i = _entries.find(key);
+	if (i == _entries.end()) {
+		++_misses;
+		return nullptr;
+	}
+
+	const Graphics::Surface &background = i->_value.background;
+	const uint rowBytes = background.w * background.format.bytesPerPixel;
+	for (int y = 0; y < background.h; ++y) {
+		if (memcmp(background.getBasePtr(0, y), dst.getBasePtr(r.left, r.top + y), rowBytes)) {
+			++_misses;
+			return nullptr;
+		}
+	}
+
+	++_hits;
+	i->_value.lastUse = ++_tick;
+	return &i->_value.image;
+}
+
+Graphics::Surface *ThemeRenderCache::add(const Key &key, const Graphics::ManagedSurface &src, const Common::Rect &r) {
+	EntryMap::iterator existing = _entries.find(key);
+	if (existing != _entries.end()) {
+		// The area holds other pixels than last time, the item is drawn again
+		Entry &entry = existing->_value;
+		entry.background.copyRectToSurface(src.rawSurface(), 0, 0, r);
+		entry.lastUse = ++_tick;
+		return &entry.image;
+	}
+
+	const uint32 bytes = 2 * r.width() * r.height() * src.format.bytesPerPixel;
+
+	while (_usedBytes + bytes > kBudget && !_entries.empty()) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+
+		_usedBytes -= oldest->_value.background.pitch * oldest->_value.background.h;
+		_usedBytes -= oldest->_value.image.pitch * oldest->_value.image.h;
+		oldest->_value.background.free();
+		oldest->_value.image.free();
+		_entries.erase(oldest);
+		++_evictions;
+	}
+
+	Entry &entry = _entries[key];
+	entry.background.create(r.width(), r.height(), src.format);
+	entry.background.copyRectToSurface(src.rawSurface(), 0, 0, r);
+	entry.image.create(r.width(), r.height(), src.format);
+	entry.lastUse = ++_tick;
+	_usedBytes += entry.background.pitch * entry.background.h;
+	_usedBytes += entry.image.pitch * entry.image.h;
+	return &entry.image;
+}
+
+void ThemeRenderCache::logStats() {
+	if (_hits == _loggedHits && _misses == _loggedMisses && _evictions == _loggedEvictions)
+		return;
+
+	const uint32 lookups = _hits + _misses;
+	debugC(kDebugLevelMainGUI, "Theme render cache: %u hits, %u misses (%u%% hits), %u evictions, %u bytes used",
+		_hits, _misses, lookups ? (uint32)((uint64)_hits * 100 / lookups) : 0, _evictions, _usedBytes);
+
+	_loggedHits = _hits;
+	_loggedMisses = _misses;
+	_loggedEvictions = _evictions;
+}
+
 /**********************************************************
  *  Data definitions for theme engine elements
  *********************************************************/
@@ -205,6 +389,8 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 		_widgets[i] = nullptr;
 	}
 
+	_renderCache = new ThemeRenderCache();
+
 	for (int i = 0; i < kTextDataMAX; ++i) {
 		_texts[i] = nullptr;
 	}
@@ -246,6 +432,8 @@ ThemeEngine::~ThemeEngine() {
 	unloadTheme();
 	unloadExtraFont();
 
+	delete _renderCache;
+
 	// Release all graphics surfaces
 	for (ImagesMap::iterator i = _bitmaps.begin(); i != _bitmaps.end(); ++i) {
 		Graphics::ManagedSurface *surf = i->_value;
@@ -464,6 +652,9 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
 
+	// The cached items are in the pixel format of the old surfaces
+	_renderCache->clear();
+
 	// Since we reinitialized our screen surfaces we know nothing has been
 	// drawn so far. Sometimes we still end up with dirty screen bits in the
 	// list. Clearing it avoids invalid overlay writes when the backend
@@ -486,6 +677,38 @@ void WidgetDrawData::calcBackgroundOffset() {
 	_shadowOffset = maxShadow;
 }
 
+void WidgetDrawData::calcCacheability() {
+	bool fgColor = false, bgColor = false, bevelColor = false, gradientColors = false;
+	bool costly = false, fillsSurface = false;
+
+	_inheritsColors = false;
+
+	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
+	        step != _steps.end(); ++step) {
+		// Filling the surface draws outside of the widget area
+		if (step->drawingCall == &Graphics::VectorRenderer::drawCallback_FILLSURFACE)
+			fillsSurface = true;
+
+		// Plain squares and lines are drawn faster than the cached pixels
+		// can be checked and copied
+		if ((step->drawingCall != &Graphics::VectorRenderer::drawCallback_SQUARE &&
+		     step->drawingCall != &Graphics::VectorRenderer::drawCallback_LINE &&
+		     step->drawingCall != &Graphics::VectorRenderer::drawCallback_VOID) ||
+		    step->fillMode == Graphics::VectorRenderer::kFillGradient || step->shadow || step->bevel)
+			costly = true;
+
+		fgColor |= step->fgColor.set;
+		bgColor |= step->bgColor.set;
+		bevelColor |= step->bevelColor.set;
+		gradientColors |= step->gradColor1.set && step->gradColor2.set;
+
+		if (!fgColor || !bgColor || !bevelColor || !gradientColors)
+			_inheritsColors = true;
+	}
+
+	_cacheable = costly && !fillsSurface;
+}
+
 void ThemeEngine::restoreBackground(Common::Rect r) {
 	if (_vectorRenderer->getActiveSurface() == &_backBuffer) {
 		// Only restore the background when drawing to the screen surface
@@ -747,6 +970,8 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 	_widgets[id] = new WidgetDrawData;
 	_widgets[id]->_layer = kDrawDataDefaults[id].layer;
 	_widgets[id]->_textDataId = kTextDataNone;
+	_widgets[id]->_cacheable = false;
+	_widgets[id]->_inheritsColors = true;
 
 	return true;
 }
@@ -777,6 +1002,7 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			warning("Missing data asset: '%s' in theme '%s", kDrawDataDefaults[i].name, themeId.c_str());
 		} else {
 			_widgets[i]->calcBackgroundOffset();
+			_widgets[i]->calcCacheability();
 		}
 	}
 
@@ -792,6 +1018,8 @@ void ThemeEngine::unloadTheme() {
 		_widgets[i] = nullptr;
 	}
 
+	_renderCache->clear();
+
 	for (int i = 0; i < kTextDataMAX; ++i) {
 		// Don't unload the language specific extra font here or it will be lost after a refresh() call.
 		if (i == kTextDataExtraLang)
@@ -946,11 +1174,55 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
+		Graphics::ManagedSurface *surface = _vectorRenderer->getActiveSurface();
 		Common::List<Graphics::DrawStep>::const_iterator step;
+
+		// Shadows reach one pixel past extendedRect. Next to the surface
+		// borders, the steps may also write into the neighbouring rows, so
+		// the cached area must not touch them.
+		Common::Rect cacheRect = extendedRect;
+		cacheRect.grow(1);
+
+		ThemeRenderCache::Key key;
+		const bool useCache = drawData->_cacheable &&
+			cacheRect.left > 0 && cacheRect.top > 0 && cacheRect.right < surface->w && cacheRect.bottom < surface->h &&
+			cacheRect.width() * cacheRect.height() <= ThemeRenderCache::kMaxArea;
+
+		if (useCache) {
+			key.state = drawData->_inheritsColors ? _vectorRenderer->getStateHash() : 0;
+			key.dynamic = dynamic;
+			key.x = area.left;
+			key.y = area.top;
+			key.width = area.width();
+			key.height = area.height();
+			key.left = cacheRect.left - area.left;
+			key.top = cacheRect.top - area.top;
+			key.right = cacheRect.right - area.left;
+			key.bottom = cacheRect.bottom - area.top;
+			key.type = type;
+
+			const Graphics::Surface *image = _renderCache->find(key, *surface, cacheRect);
+			if (image) {
+				// Leave the renderer in the same state as drawing would
+				for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+					_vectorRenderer->setupStep(area, _clip, *step, dynamic);
+				}
+
+				surface->copyRectToSurface(*image, cacheRect.left, cacheRect.top, Common::Rect(image->w, image->h));
+				addDirtyRect(extendedRect);
+				return;
+			}
+		}
+
+		Graphics::Surface *cacheImage = useCache ? _renderCache->add(key, *surface, cacheRect) : nullptr;
+
 		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
 			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
 		}
 
+		if (cacheImage)
+			cacheImage->copyRectToSurface(surface->rawSurface(), 0, 0, cacheRect);
+
 		addDirtyRect(extendedRect);
 	}
 }
@@ -1528,6 +1800,8 @@ void ThemeEngine::updateScreen() {
 #else
 	updateDirtyScreen();
 #endif
+
+	_renderCache->logStats();
 }
 
 void ThemeEngine::addDirtyRect(Common::Rect r) {
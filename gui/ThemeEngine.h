@@ -48,6 +48,7 @@ class VectorRenderer;
 namespace GUI {
 
 struct WidgetDrawData;
+class ThemeRenderCache;
 struct TextDrawData;
 class Dialog;
 class GuiObject;
@@ -789,6 +790,9 @@ protected:
 	 */
 	WidgetDrawData *_widgets[kDrawDataMAX];
 
+	/** Cache of drawn DrawData items, see drawDD() */
+	ThemeRenderCache *_renderCache;
+
 	/** Array of all the text fonts that can be drawn. */
 	TextDrawData *_texts[kTextDataMAX];
 
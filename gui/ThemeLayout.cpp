@@ -204,21 +204,74 @@ bool ThemeLayoutWidget::isBound(Widget *widgetChain) const {
 }
 
 Widget *ThemeLayoutWidget::getWidget(Widget *widgetChain) const {
-	const ThemeLayout *topLevelLayout = this;
-	while (topLevelLayout->_parent) {
-		topLevelLayout = topLevelLayout->_parent;
+	if (_fullName.empty()) {
+		const ThemeLayout *topLevelLayout = this;
+		while (topLevelLayout->_parent) {
+			topLevelLayout = topLevelLayout->_parent;
+		}
+
+		assert(topLevelLayout && topLevelLayout->getLayoutType() == kLayoutMain);
+		const ThemeLayoutMain *dialogLayout = static_cast<const ThemeLayoutMain *>(topLevelLayout);
+
+		_fullName = Common::String::format("%s.%s", dialogLayout->getName(), _name.c_str());
 	}
 
-	assert(topLevelLayout && topLevelLayout->getLayoutType() == kLayoutMain);
-	const ThemeLayoutMain *dialogLayout = static_cast<const ThemeLayoutMain *>(topLevelLayout);
+	return Widget::findWidgetInChain(widgetChain, _fullName.c_str());
+}
+
+bool ThemeLayoutMain::getWidgetData(const Common::String &name, int16 &x, int16 &y, int16 &w, int16 &h, bool &useRTL) {
+	if (!_indexed || name.empty())
+		return ThemeLayout::getWidgetData(name, x, y, w, h, useRTL);
+
+	WidgetIndex::const_iterator i = _widgetIndex.find(name);
+	if (i == _widgetIndex.end())
+		return false;
+
+	return i->_value->getWidgetData(name, x, y, w, h, useRTL);
+}
+
+Graphics::TextAlign ThemeLayoutMain::getWidgetTextHAlign(const Common::String &name) {
+	if (!_indexed || name.empty())
+		return ThemeLayout::getWidgetTextHAlign(name);
+
+	WidgetIndex::const_iterator i = _widgetIndex.find(name);
+	if (i == _widgetIndex.end())
+		return Graphics::kTextAlignInvalid;
+
+	return i->_value->getWidgetTextHAlign(name);
+}
+
+void ThemeLayoutMain::indexWidgets(ThemeLayout *layout) {
+	for (uint i = 0; i < layout->_children.size(); ++i) {
+		ThemeLayout *child = layout->_children[i];
+
+		switch (child->getLayoutType()) {
+		case kLayoutWidget:
+		case kLayoutTabWidget:
+		case kLayoutScrollContainerWidget:
+			// The first widget of a given name wins, like when searching the tree
+			if (!_widgetIndex.contains(child->getName()))
+				_widgetIndex[child->getName()] = child;
+			break;
 
-	Common::String widgetName = Common::String::format("%s.%s", dialogLayout->getName(), _name.c_str());
-	return Widget::findWidgetInChain(widgetChain, widgetName.c_str());
+		case kLayoutSpace:
+			break;
+
+		default:
+			indexWidgets(child);
+			break;
+		}
+	}
 }
 
 void ThemeLayoutMain::reflowLayout(Widget *widgetChain) {
 	assert(_children.size() <= 1);
 
+	if (!_indexed) {
+		indexWidgets(this);
+		_indexed = true;
+	}
+
 	resetLayout();
 
 	if (_overlays == "screen") {
@@ -23,6 +23,8 @@
 #define THEME_LAYOUT_H
 
 #include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 #include "common/rect.h"
 #include "graphics/font.h"
 
@@ -146,7 +148,8 @@ public:
 			ThemeLayout(nullptr),
 			_name(name),
 			_overlays(overlays),
-			_inset(inset) {
+			_inset(inset),
+			_indexed(false) {
 		_w = _defaultW = width;
 		_h = _defaultH = height;
 		_x = _defaultX = -1;
@@ -154,6 +157,9 @@ public:
 	}
 	void reflowLayout(Widget *widgetChain) override;
 
+	bool getWidgetData(const Common::String &name, int16 &x, int16 &y, int16 &w, int16 &h, bool &useRTL) override;
+	Graphics::TextAlign getWidgetTextHAlign(const Common::String &name) override;
+
 	void resetLayout() override {
 		ThemeLayout::resetLayout();
 		_x = _defaultX;
@@ -172,6 +178,17 @@ protected:
 	Common::String _name;
 	Common::String _overlays;
 	int _inset;
+
+	/**
+	 * Index of the widget layouts by name, so that looking up the position
+	 * of a widget does not search the whole layout tree. It is built on the
+	 * first reflow, once the dialog layout is complete.
+	 */
+	void indexWidgets(ThemeLayout *layout);
+
+	typedef Common::HashMap<Common::String, ThemeLayout *> WidgetIndex;
+	WidgetIndex _widgetIndex;
+	bool _indexed;
 };
 
 class ThemeLayoutStacked : public ThemeLayout {
@@ -244,12 +261,14 @@ protected:
 	Widget *getWidget(Widget *widgetChain) const;
 
 	ThemeLayout *makeClone(ThemeLayout *newParent) override {
-		ThemeLayout *n = new ThemeLayoutWidget(*this);
+		ThemeLayoutWidget *n = new ThemeLayoutWidget(*this);
 		n->_parent = newParent;
+		n->_fullName.clear();
 		return n;
 	}
 
 	Common::String _name;
+	mutable Common::String _fullName; ///< Name of the GUI widget, "Dialog.Widget"
 };
 
 class ThemeLayoutTabWidget : public ThemeLayoutWidget {
@@ -282,6 +301,7 @@ protected:
 	ThemeLayout *makeClone(ThemeLayout *newParent) override {
 		ThemeLayoutTabWidget *n = new ThemeLayoutTabWidget(*this);
 		n->_parent = newParent;
+		n->_fullName.clear();
 		return n;
 	}
 };
@@ -316,6 +336,7 @@ protected:
 	ThemeLayout *makeClone(ThemeLayout *newParent) override {
 		ThemeLayoutScrollContainerWidget *n = new ThemeLayoutScrollContainerWidget(*this);
 		n->_parent = newParent;
+		n->_fullName.clear();
 		return n;
 	}
 };
@@ -74,6 +74,12 @@ public:
 	 */
 	bool isActive() const { return _isActive; }
 
+	/**
+	 * Return true if the debugger has been attached, i.e. one of the
+	 * next calls to onFrame() is going to activate it.
+	 */
+	bool isAttached() const { return _frameCountdown > 0; }
+
 protected:
 	typedef Common::Functor1<const char *, bool> defaultCommand;
 	typedef Common::Functor2<int, const char **, bool> Debuglet;
@@ -372,12 +372,24 @@ void LauncherDialog::close() {
 	Dialog::close();
 }
 
+// Orders entry indices like scumm_compareDictionary() orders the descriptions,
+// using keys computed once per entry instead of on every comparison
 struct LauncherEntryComparator {
-	bool operator()(const LauncherEntry &x, const LauncherEntry &y) const {
-			return scumm_compareDictionary(x.description.c_str(), y.description.c_str()) < 0;
+	const Common::StringArray &_keys;
+
+	LauncherEntryComparator(const Common::StringArray &keys) : _keys(keys) {}
+
+	bool operator()(uint x, uint y) const {
+		return strcmp(_keys[x].c_str(), _keys[y].c_str()) < 0;
 	}
 };
 
+static Common::String makeDictionaryKey(const Common::String &description) {
+	Common::String key(scumm_skipArticle(description.c_str()));
+	key.toLowercase();
+	return key;
+}
+
 
 
 void LauncherDialog::addGame() {
@@ -614,10 +626,25 @@ Common::Array<LauncherEntry> LauncherDialog::generateEntries(const Common::Confi
 			domainList.push_back(LauncherEntry(iter->_key, engineid, gameid, description, title, &iter->_value));
 	}
 
-	// Now sort the list in dictionary order
-	Common::sort(domainList.begin(), domainList.end(), LauncherEntryComparator());
+	// Now sort the list in dictionary order. Sort indices, as moving the
+	// entries around copies all their strings.
+	Common::StringArray keys;
+	Common::Array<uint> order;
+	keys.reserve(domainList.size());
+	order.reserve(domainList.size());
+	for (uint i = 0; i < domainList.size(); ++i) {
+		keys.push_back(makeDictionaryKey(domainList[i].description));
+		order.push_back(i);
+	}
+
+	Common::sort(order.begin(), order.end(), LauncherEntryComparator(keys));
+
+	Common::Array<LauncherEntry> sortedList;
+	sortedList.reserve(domainList.size());
+	for (uint i = 0; i < order.size(); ++i)
+		sortedList.push_back(domainList[order[i]]);
 
-	return domainList;
+	return sortedList;
 }
 
 void LauncherDialog::handleKeyDown(Common::KeyState state) {
@@ -1572,9 +1599,12 @@ void LauncherGrid::handleCommand(CommandSender *sender, uint32 cmd, uint32 data)
 }
 
 void LauncherGrid::updateListing(int selPos) {
+	int numEntries = ConfMan.getInt("gui_list_max_scan_entries");
+
 	// Retrieve a list of all games defined in the config file
 	_domains.clear();
 	const Common::ConfigManager::DomainMap &domains = ConfMan.getGameDomains();
+	bool scanEntries = numEntries == -1 ? true : ((int)domains.size() <= numEntries);
 
 	// Turn it into a sorted list of entries
 	Common::Array<LauncherEntry> domainList = generateEntries(domains);
@@ -1594,7 +1624,12 @@ void LauncherGrid::updateListing(int selPos) {
 		iter->domain->tryGetVal("language", language);
 		iter->domain->tryGetVal("platform", platform);
 		iter->domain->tryGetVal("extra", extra);
-		valid_path = (!iter->domain->tryGetVal("path", path) || !Common::FSNode(Common::Path::fromConfig(path)).isDirectory()) ? false : true;
+		// Checking the path hits the file system, so for large libraries
+		// the entries are all shown as valid, like in the list view
+		if (scanEntries)
+			valid_path = (!iter->domain->tryGetVal("path", path) || !Common::FSNode(Common::Path::fromConfig(path)).isDirectory()) ? false : true;
+		else
+			valid_path = true;
 		gridList.push_back(GridItemInfo(k++, engineid, gameid, iter->description, iter->title, extra, Common::parseLanguage(language), Common::parsePlatform(platform), valid_path));
 		_domains.push_back(iter->key);
 	}
@@ -508,8 +508,11 @@ void GridWidget::setEntryList(Common::Array<GridItemInfo> *list) {
 	_isGridInvalid = true;
 	_selectedEntry = nullptr;
 
+	_dataEntryList.reserve(list->size());
 	for (Common::Array<GridItemInfo>::iterator entryIter = list->begin(); entryIter != list->end(); ++entryIter) {
 		_dataEntryList.push_back(*entryIter);
+		_dataEntryList.back().searchTitle = entryIter->title;
+		_dataEntryList.back().searchTitle.toLowercase();
 	}
 	// TODO: Remove this below, add drawWidget(), that should do the drawing
 	if (!_gridItems.empty()) {
@@ -588,18 +591,15 @@ void GridWidget::sortGroups() {
 		// as substrings, ignoring case.
 
 		Common::U32StringTokenizer tok(_filter);
-		Common::U32String tmp;
 		int n = 0;
 
 		_sortedEntryList.clear();
 
 		for (GridItemInfo *i = _dataEntryList.begin(); i != _dataEntryList.end(); ++i, ++n) {
-			tmp = i->title;
-			tmp.toLowercase();
 			bool matches = true;
 			tok.reset();
 			while (!tok.empty()) {
-				if (!tmp.contains(tok.nextToken())) {
+				if (!i->searchTitle.contains(tok.nextToken())) {
 					matches = false;
 					break;
 				}
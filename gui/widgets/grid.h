@@ -58,6 +58,8 @@ struct GridItemInfo {
 	Common::String 		thumbPath;
 	// Generic attribute value, may be any piece of metadata
 	Common::String		attribute;
+	// Lowercase title, matched by the filter
+	Common::U32String	searchTitle;
 	Common::Language	language;
 	Common::Platform 	platform;
 
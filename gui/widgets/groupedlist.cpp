@@ -443,19 +443,16 @@ void GroupedListWidget::setFilter(const Common::U32String &filter, bool redraw)
 		// as substrings, ignoring case.
 
 		Common::U32StringTokenizer tok(_filter);
-		Common::U32String tmp;
 		int n = 0;
 
 		_list.clear();
 		_listIndex.clear();
 
 		for (auto i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = i->clean;
-			tmp.toLowercase();
 			bool matches = true;
 			tok.reset();
 			while (!tok.empty()) {
-				if (!_filterMatcher(_filterMatcherArg, n, tmp, tok.nextToken())) {
+				if (!_filterMatcher(_filterMatcherArg, n, i->clean, tok.nextToken())) {
 					matches = false;
 					break;
 				}
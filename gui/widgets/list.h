@@ -54,9 +54,9 @@ public:
 
 	struct ListData {
 		Common::U32String orig;
-		Common::U32String clean;
+		Common::U32String clean; ///< Lowercase text without GUI formatting, matched by the filter
 
-		ListData(const Common::U32String &o, const Common::U32String &c) { orig = o; clean = c; }
+		ListData(const Common::U32String &o, const Common::U32String &c) { orig = o; clean = c; clean.toLowercase(); }
 	};
 
 	typedef Common::Array<ListData> ListDataArray;
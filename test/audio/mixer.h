@@ -0,0 +1,171 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_intern.h"
+#include "audio/decoders/raw.h"
+#include "audio/audiostream.h"
+
+#include "common/config-manager.h"
+#include "common/memstream.h"
+
+#include "helper.h"
+
+class MixerTestSuite : public CxxTest::TestSuite
+{
+private:
+	Audio::SoundHandle playSine(Audio::MixerImpl &mixer, int id) {
+		int16 *sine;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(11025, 1, &sine, false, false);
+		delete[] sine;
+
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, s, id, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::YES, false, false);
+		return handle;
+	}
+
+	void mix(Audio::MixerImpl &mixer, int samples) {
+		int16 *buffer = new int16[samples * 2];
+		mixer.mixCallback((byte *)buffer, samples * 2 * sizeof(int16));
+		delete[] buffer;
+	}
+
+	// Plays a tone above the Nyquist frequency of the mixer, and returns
+	// the RMS of what is left of it after resampling
+	double mixAliasedTone(Audio::MixerImpl &mixer) {
+		const int samples = 8820;
+		int16 *tone = new int16[samples];
+		for (int i = 0; i < samples; i++)
+			tone[i] = (int16)(sin(2 * M_PI * 15000 * i / 44100.0) * 16000);
+
+		Common::SeekableReadStream *s = new Common::MemoryReadStream((const byte *)tone, samples * sizeof(int16), DisposeAfterUse::YES);
+		Audio::SeekableAudioStream *stream = Audio::makeRawStream(s, 44100, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                                          | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                                                         );
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kPlainSoundType, &handle, stream, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::YES, false, false);
+
+		const int outSamples = 2048;
+		int16 *buffer = new int16[outSamples * 2];
+		mixer.mixCallback((byte *)buffer, outSamples * 2 * sizeof(int16));
+		double sum = 0;
+		for (int i = 64; i < outSamples; i++)
+			sum += (double)buffer[i * 2] * buffer[i * 2];
+		delete[] buffer;
+
+		mixer.stopHandle(handle);
+		return sqrt(sum / (outSamples - 64));
+	}
+
+public:
+	void test_channel_queries() {
+		Audio::MixerImpl mixer(22050, true, 512);
+		mixer.setReady(true);
+
+		Audio::SoundHandle handle = playSine(mixer, 42);
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+		TS_ASSERT(mixer.isSoundIDActive(42));
+		TS_ASSERT(!mixer.isSoundIDActive(43));
+		TS_ASSERT_EQUALS(mixer.getSoundID(handle), 42);
+		TS_ASSERT(mixer.hasActiveChannelOfType(Audio::Mixer::kSFXSoundType));
+		TS_ASSERT(!mixer.hasActiveChannelOfType(Audio::Mixer::kMusicSoundType));
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 11025U);
+
+		mixer.stopHandle(handle);
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+		TS_ASSERT(!mixer.isSoundIDActive(42));
+		TS_ASSERT(!mixer.hasActiveChannelOfType(Audio::Mixer::kSFXSoundType));
+
+		Audio::SoundHandle invalid;
+		TS_ASSERT(!mixer.isSoundHandleActive(invalid));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(invalid), 0);
+	}
+
+	void test_channel_setters() {
+		Audio::MixerImpl mixer(22050, true, 512);
+		mixer.setReady(true);
+
+		Audio::SoundHandle handle = playSine(mixer, -1);
+
+		// Changes are visible right away, even before the mixer applied them
+		mixer.setChannelVolume(handle, 100);
+		mixer.setChannelBalance(handle, -20);
+		mixer.setChannelRate(handle, 22050);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 100);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), -20);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 22050U);
+
+		mix(mixer, 256);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 100);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), -20);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 22050U);
+
+		mixer.resetChannelRate(handle);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 11025U);
+
+		// More changes than the queue holds must not be lost
+		for (int i = 0; i < 200; i++)
+			mixer.setChannelVolume(handle, i);
+		mix(mixer, 256);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 199);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 11025U);
+	}
+
+	void test_finished_channel() {
+		Audio::MixerImpl mixer(22050, true, 512);
+		mixer.setReady(true);
+
+		Audio::SoundHandle handle = playSine(mixer, -1);
+		mixer.setChannelVolume(handle, 10);
+
+		// One second of input at twice the rate drains the stream
+		for (int i = 0; i < 100 && mixer.isSoundHandleActive(handle); i++)
+			mix(mixer, 512);
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 0);
+	}
+
+	void test_rate_converter_config() {
+		ConfMan.set("rate_converter", "polyphase", Common::ConfigManager::kTransientDomain);
+		Audio::MixerImpl polyphase(22050, true, 512);
+		polyphase.setReady(true);
+		ConfMan.removeKey("rate_converter", Common::ConfigManager::kTransientDomain);
+
+		Audio::MixerImpl linear(22050, true, 512);
+		linear.setReady(true);
+
+		TS_ASSERT_EQUALS(polyphase.getRateConverterQuality(), Audio::kRateConverterPolyphase);
+		TS_ASSERT_EQUALS(linear.getRateConverterQuality(), Audio::kRateConverterLinear);
+
+		// The setting reaches the rate converters of the channels
+		const double filtered = mixAliasedTone(polyphase);
+		const double aliased = mixAliasedTone(linear);
+		TS_ASSERT_LESS_THAN(filtered * 10, aliased);
+
+		linear.setRateConverterQuality(Audio::kRateConverterPolyphase);
+		TS_ASSERT_LESS_THAN(mixAliasedTone(linear) * 10, aliased);
+	}
+
+	void test_reused_slot() {
+		Audio::MixerImpl mixer(22050, true, 512);
+		mixer.setReady(true);
+
+		Audio::SoundHandle oldHandle = playSine(mixer, -1);
+		mixer.setChannelVolume(oldHandle, 10);
+		mixer.stopHandle(oldHandle);
+
+		// The new sound gets the same slot, but a different handle
+		Audio::SoundHandle newHandle = playSine(mixer, -1);
+		TS_ASSERT(!mixer.isSoundHandleActive(oldHandle));
+		TS_ASSERT(mixer.isSoundHandleActive(newHandle));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(newHandle), Audio::Mixer::kMaxChannelVolume);
+
+		// Changes through the stale handle must not reach the new sound
+		mixer.setChannelVolume(oldHandle, 20);
+		mixer.setChannelBalance(oldHandle, 30);
+		mix(mixer, 256);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(newHandle), Audio::Mixer::kMaxChannelVolume);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(newHandle), 0);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(oldHandle), 0);
+	}
+};
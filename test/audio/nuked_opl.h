@@ -0,0 +1,152 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/opl/nuked.h"
+#include "common/util.h"
+
+#ifndef DISABLE_NUKED_OPL
+
+// A short register log in the style of an AdLib music driver: melodic voices
+// with vibrato and tremolo, a rhythm section, and an OPL3 part with 4-op
+// channels, the extra waveforms and panning. Each entry renders 'wait' output
+// samples before the register write.
+struct NukedOPLLogEntry {
+	uint16 wait;
+	uint16 reg;
+	uint8 val;
+};
+
+static const NukedOPLLogEntry nukedOPLLog[] = {
+	// OPL2 melodic: channel 0 sine with vibrato, channel 1 with feedback and tremolo
+	{   0, 0x001, 0x20 }, { 0, 0x0bd, 0xc0 },
+	{   0, 0x020, 0x61 }, { 0, 0x023, 0x41 }, { 0, 0x040, 0x1a }, { 0, 0x043, 0x00 },
+	{   0, 0x060, 0xf2 }, { 0, 0x063, 0xf3 }, { 0, 0x080, 0x24 }, { 0, 0x083, 0x36 },
+	{   0, 0x0e0, 0x01 }, { 0, 0x0e3, 0x00 }, { 0, 0x0c0, 0x0e },
+	{   0, 0x021, 0xa2 }, { 0, 0x024, 0x81 }, { 0, 0x041, 0x52 }, { 0, 0x044, 0x03 },
+	{   0, 0x061, 0x9f }, { 0, 0x064, 0x84 }, { 0, 0x081, 0x07 }, { 0, 0x084, 0x45 },
+	{   0, 0x0e1, 0x02 }, { 0, 0x0e4, 0x03 }, { 0, 0x0c1, 0x07 },
+	{   0, 0x0a0, 0x98 }, { 0, 0x0b0, 0x31 },
+	{ 700, 0x0a1, 0x41 }, { 0, 0x0b1, 0x2a },
+	{ 3000, 0x0b0, 0x11 },
+	{ 800, 0x0a0, 0x6b }, { 0, 0x0b0, 0x35 },
+	{ 2500, 0x0b1, 0x0a },
+	{ 1200, 0x0b0, 0x15 },
+	// Rhythm mode: bass drum, snare, tom, cymbal and hi-hat
+	{ 400, 0x030, 0x01 }, { 0, 0x033, 0x01 }, { 0, 0x050, 0x0b }, { 0, 0x053, 0x00 },
+	{   0, 0x070, 0xa8 }, { 0, 0x073, 0xd6 }, { 0, 0x090, 0x4c }, { 0, 0x093, 0x4f },
+	{   0, 0x0c6, 0x00 }, { 0, 0x0a6, 0x57 }, { 0, 0x0b6, 0x09 },
+	{   0, 0x031, 0x0c }, { 0, 0x034, 0x01 }, { 0, 0x051, 0x00 }, { 0, 0x054, 0x00 },
+	{   0, 0x071, 0xf8 }, { 0, 0x074, 0xf7 }, { 0, 0x091, 0xb5 }, { 0, 0x094, 0xb5 },
+	{   0, 0x0a7, 0x03 }, { 0, 0x0b7, 0x0a }, { 0, 0x0a8, 0x57 }, { 0, 0x0b8, 0x09 },
+	{   0, 0x032, 0x04 }, { 0, 0x035, 0x01 }, { 0, 0x052, 0x00 }, { 0, 0x055, 0x00 },
+	{   0, 0x072, 0xf6 }, { 0, 0x075, 0xf6 }, { 0, 0x092, 0x67 }, { 0, 0x095, 0x67 },
+	{   0, 0x0bd, 0xff },
+	{ 1500, 0x0bd, 0xe0 },
+	{ 300, 0x0bd, 0xf5 },
+	{ 1500, 0x0bd, 0xea },
+	{ 1500, 0x0bd, 0x00 },
+	// OPL3: 4-op channel 0+3 on the second bank, all eight waveforms, panning
+	{ 600, 0x105, 0x01 }, { 0, 0x104, 0x01 },
+	{   0, 0x120, 0x21 }, { 0, 0x123, 0x31 }, { 0, 0x128, 0x22 }, { 0, 0x12b, 0x21 },
+	{   0, 0x140, 0x20 }, { 0, 0x143, 0x18 }, { 0, 0x148, 0x10 }, { 0, 0x14b, 0x00 },
+	{   0, 0x160, 0xf4 }, { 0, 0x163, 0xf3 }, { 0, 0x168, 0xe2 }, { 0, 0x16b, 0xd3 },
+	{   0, 0x180, 0x15 }, { 0, 0x183, 0x26 }, { 0, 0x188, 0x33 }, { 0, 0x18b, 0x17 },
+	{   0, 0x1e0, 0x04 }, { 0, 0x1e3, 0x05 }, { 0, 0x1e8, 0x06 }, { 0, 0x1eb, 0x07 },
+	{   0, 0x1c0, 0x1b }, { 0, 0x1c3, 0x21 },
+	{   0, 0x1a0, 0x81 }, { 0, 0x1b0, 0x2d },
+	{   0, 0x0e0, 0x05 }, { 0, 0x0c0, 0x2e },
+	{   0, 0x0a0, 0xb0 }, { 0, 0x0b0, 0x32 },
+	{ 2000, 0x1b0, 0x0d },
+	{ 500, 0x0b0, 0x12 },
+	{ 2500, 0x0bd, 0x00 },
+	{   0, 0x000, 0x00 }
+};
+
+static uint32 renderNukedOPLLog(OPL::NUKED::opl3_chip *chip, uint32 rate, bool block, uint32 *numSamples) {
+	int16 buffer[2 * 1024];
+	uint32 checksum = 0x811c9dc5;
+	uint32 total = 0;
+
+	OPL::NUKED::OPL3_Reset(chip, rate);
+
+	for (const NukedOPLLogEntry *entry = nukedOPLLog; ; ++entry) {
+		uint32 left = entry->wait;
+		while (left) {
+			const uint32 len = MIN<uint32>(left, 1024);
+			if (block) {
+				OPL::NUKED::OPL3_GenerateStream(chip, buffer, len);
+			} else {
+				for (uint32 i = 0; i < len; i++)
+					OPL::NUKED::OPL3_GenerateResampled(chip, buffer + 2 * i);
+			}
+			for (uint32 i = 0; i < 2 * len; i++) {
+				checksum = (checksum ^ (uint16)buffer[i]) * 0x01000193;
+			}
+			total += len;
+			left -= len;
+		}
+		if (!entry->reg)
+			break;
+		OPL::NUKED::OPL3_WriteRegBuffered(chip, entry->reg, entry->val);
+	}
+
+	*numSamples = total;
+	return checksum;
+}
+
+#endif
+
+class NukedOPLTestSuite : public CxxTest::TestSuite {
+private:
+	void checkRate(uint32 rate, uint32 golden) {
+#ifndef DISABLE_NUKED_OPL
+		OPL::NUKED::opl3_chip *chip = new OPL::NUKED::opl3_chip;
+		uint32 numSamples;
+
+		TS_ASSERT_EQUALS(renderNukedOPLLog(chip, rate, false, &numSamples), golden);
+		TS_ASSERT_EQUALS(numSamples, 19000u);
+		TS_ASSERT_EQUALS(renderNukedOPLLog(chip, rate, true, &numSamples), golden);
+
+		delete chip;
+#endif
+	}
+
+public:
+	// The checksums were recorded with the sample by sample renderer, before
+	// block rendering was added. Any change to them means the output changed.
+	void test_golden_output_native_rate() {
+		checkRate(49716, 0x5e0b1e90);
+	}
+
+	void test_golden_output_44100() {
+		checkRate(44100, 0x9dfb8594);
+	}
+
+	void test_golden_output_22050() {
+		checkRate(22050, 0x23d7e8e8);
+	}
+
+	// Below about 194 Hz one output sample needs more chip samples than a
+	// block holds, block rendering has to match the sample by sample output
+	void test_low_output_rate() {
+#ifndef DISABLE_NUKED_OPL
+		OPL::NUKED::opl3_chip *blockChip = new OPL::NUKED::opl3_chip;
+		OPL::NUKED::opl3_chip *sampleChip = new OPL::NUKED::opl3_chip;
+		int16 blockBuffer[2 * 64], sampleBuffer[2 * 64];
+
+		OPL::NUKED::OPL3_Reset(blockChip, 150);
+		OPL::NUKED::OPL3_Reset(sampleChip, 150);
+		for (const NukedOPLLogEntry *entry = nukedOPLLog; !entry->wait && entry->reg; ++entry) {
+			OPL::NUKED::OPL3_WriteRegBuffered(blockChip, entry->reg, entry->val);
+			OPL::NUKED::OPL3_WriteRegBuffered(sampleChip, entry->reg, entry->val);
+		}
+
+		OPL::NUKED::OPL3_GenerateStream(blockChip, blockBuffer, 64);
+		for (uint32 i = 0; i < 64; i++)
+			OPL::NUKED::OPL3_GenerateResampled(sampleChip, sampleBuffer + 2 * i);
+		TS_ASSERT_SAME_DATA(blockBuffer, sampleBuffer, sizeof(blockBuffer));
+
+		delete blockChip;
+		delete sampleChip;
+#endif
+	}
+};
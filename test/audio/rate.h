@@ -0,0 +1,337 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "audio/rate_polyphase.h"
+#include "audio/decoders/raw.h"
+
+#include "common/memstream.h"
+
+#include <math.h>
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+private:
+	static Audio::SeekableAudioStream *createToneStream(int sampleRate, int frequency, int samples, int16 amplitude) {
+		int16 *tone = (int16 *)malloc(sizeof(int16) * samples);
+		for (int i = 0; i < samples; ++i)
+			tone[i] = (int16)(sin(2 * M_PI * frequency * i / sampleRate) * amplitude);
+
+		Common::SeekableReadStream *s = new Common::MemoryReadStream((const byte *)tone, sizeof(int16) * samples, DisposeAfterUse::YES);
+		return Audio::makeRawStream(s, sampleRate, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                 | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                           );
+	}
+
+	// Converts the whole stream and returns the number of output samples
+	static int convert(Audio::RateConverter *converter, Audio::AudioStream *stream, int16 *out, int maxSamples) {
+		memset(out, 0, sizeof(int16) * maxSamples);
+
+		int total = 0;
+		while (total < maxSamples) {
+			int converted = converter->convert(*stream, out + total, MIN(256, maxSamples - total), Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+			if (converted == 0)
+				break;
+			total += converted;
+		}
+		return total;
+	}
+
+	static double rms(const int16 *samples, int count) {
+		double sum = 0;
+		for (int i = 0; i < count; ++i)
+			sum += (double)samples[i] * samples[i];
+		return sqrt(sum / count);
+	}
+
+	static int16 referenceSample(int i) {
+		return (int16)(sin(2 * M_PI * 1000 * i / 22050.0) * 6000 + sin(2 * M_PI * 1700 * i / 22050.0 + 1.0) * 4000);
+	}
+
+	// The output sample at position t of the input, computed in double
+	// precision from the definition of the filter
+	static double referenceFilter(const int16 *samples, int count, double t, double cutoff) {
+		const int halfTaps = Audio::POLYPHASE_TAPS / 2;
+		const int first = (int)floor(t) - (halfTaps - 1);
+		double sum = 0, gain = 0;
+		for (int k = first; k < first + Audio::POLYPHASE_TAPS; ++k) {
+			const double x = k - t;
+			const double sinc = (x == 0.0) ? 1.0 : sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+			const double window = (fabs(x) >= halfTaps) ? 0.0 :
+				0.42 + 0.5 * cos(M_PI * x / halfTaps) + 0.08 * cos(2.0 * M_PI * x / halfTaps);
+			gain += sinc * window;
+			if (k >= 0 && k < count)
+				sum += samples[k] * sinc * window;
+		}
+		return sum / gain;
+	}
+
+	static void checkReference(int inRate, int outRate) {
+		const int inSamples = 4096;
+		const int outSamples = (int)((int64)(inSamples - 64) * outRate / inRate);
+
+		// Different signals on both channels, to check that they are kept apart
+		int16 *samples = new int16[inSamples * 2];
+		int16 *left = new int16[inSamples];
+		int16 *right = new int16[inSamples];
+		for (int i = 0; i < inSamples; ++i) {
+			left[i] = samples[i * 2 + 0] = referenceSample(i);
+			right[i] = samples[i * 2 + 1] = -referenceSample(i + 100) / 2;
+		}
+
+		Common::SeekableReadStream *s = new Common::MemoryReadStream((const byte *)samples, sizeof(int16) * inSamples * 2, DisposeAfterUse::NO);
+		Audio::SeekableAudioStream *stream = Audio::makeRawStream(s, inRate, Audio::FLAG_16BITS | Audio::FLAG_STEREO
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                                          | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                                                         );
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, true, true, false, Audio::kRateConverterPolyphase);
+
+		int16 *out = new int16[outSamples * 2];
+		memset(out, 0, sizeof(int16) * outSamples * 2);
+		TS_ASSERT_EQUALS(converter->convert(*stream, out, outSamples, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), outSamples);
+
+		// Output sample n lies n steps into the input, delayed by half the
+		// filter length. The converter steps in 16.16 fixed point like the
+		// other converters, so the reference uses the same step. The phase is
+		// rounded to 1 / 256 of a sample, and the coefficients to 14 bits,
+		// which allows a few units of difference.
+		const double cutoff = 0.95 * MIN(1.0, (double)outRate / inRate);
+		const double step = (double)(((int64)inRate << 16) / outRate) / 65536;
+		const int delay = Audio::POLYPHASE_TAPS / 2;
+		int maxError = 0;
+		for (int n = 0; n < outSamples; ++n) {
+			const double t = n * step - delay;
+			maxError = MAX(maxError, ABS(out[n * 2 + 0] - (int)floor(referenceFilter(left, inSamples, t, cutoff) + 0.5)));
+			maxError = MAX(maxError, ABS(out[n * 2 + 1] - (int)floor(referenceFilter(right, inSamples, t, cutoff) + 0.5)));
+		}
+		TS_ASSERT_LESS_THAN_EQUALS(maxError, 16);
+
+		delete[] out;
+		delete converter;
+		delete stream;
+		delete[] right;
+		delete[] left;
+		delete[] samples;
+	}
+
+	// The per frame mixing loop copyConvert() used before it mixed whole runs
+	static void referenceMix(const int16 *in, int frames, bool inStereo, bool outStereo, bool reverseStereo, int16 *out, int volL, int volR) {
+		for (int i = 0; i < frames; ++i) {
+			const int inL = in[0];
+			const int inR = inStereo ? in[1] : inL;
+			in += inStereo ? 2 : 1;
+
+			const int outL = (inL * volL) / Audio::Mixer::kMaxMixerVolume;
+			const int outR = (inR * volR) / Audio::Mixer::kMaxMixerVolume;
+
+			if (outStereo) {
+				Audio::clampedAdd(out[reverseStereo    ], outL);
+				Audio::clampedAdd(out[reverseStereo ^ 1], outR);
+				out += 2;
+			} else {
+				Audio::clampedAdd(out[0], (outL + outR) / 2);
+				out += 1;
+			}
+		}
+	}
+
+	static void checkCopyConvert(bool inStereo, bool outStereo, bool reverseStereo, int volL, int volR) {
+		// More samples than fit the converter buffer at once
+		const int inChannels = inStereo ? 2 : 1;
+		const int outChannels = outStereo ? 2 : 1;
+		const int frames = 1501;
+		const int inSamples = frames * inChannels;
+
+		int16 *samples = new int16[inSamples];
+		uint32 seed = 1;
+		for (int i = 0; i < inSamples; ++i) {
+			seed = seed * 1103515245 + 12345;
+			samples[i] = (i % 97 == 0) ? ((i & 1) ? -32768 : 32767) : (int16)(seed >> 16);
+		}
+
+		// Start from loud output, so the mix clips in both directions
+		int16 *out = new int16[(frames + 16) * outChannels];
+		int16 *expected = new int16[(frames + 16) * outChannels];
+		for (int i = 0; i < (frames + 16) * outChannels; ++i)
+			out[i] = expected[i] = (int16)((i % 5 - 2) * 12000);
+		referenceMix(samples, frames, inStereo, outStereo, reverseStereo, expected, volL, volR);
+
+		Common::SeekableReadStream *s = new Common::MemoryReadStream((const byte *)samples, sizeof(int16) * inSamples, DisposeAfterUse::NO);
+		Audio::SeekableAudioStream *stream = Audio::makeRawStream(s, 22050, Audio::FLAG_16BITS | (inStereo ? Audio::FLAG_STEREO : 0)
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                                          | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                                                         );
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 22050, inStereo, outStereo, reverseStereo);
+
+		// Requests of varying sizes end both inside and at the end of the
+		// converter buffer
+		static const int requestSizes[] = { 1, 7, 255, 256, 1000, 3 };
+		int total = 0;
+		for (int request = 0; total < frames + 16; ++request) {
+			const int size = MIN(requestSizes[request % ARRAYSIZE(requestSizes)], frames + 16 - total);
+			const int converted = converter->convert(*stream, out + total * outChannels, size, volL, volR);
+			total += converted;
+			if (converted < size)
+				break;
+		}
+
+		TS_ASSERT_EQUALS(total, frames);
+		TS_ASSERT_EQUALS(memcmp(out, expected, sizeof(int16) * (frames + 16) * outChannels), 0);
+
+		delete converter;
+		delete stream;
+		delete[] expected;
+		delete[] out;
+		delete[] samples;
+	}
+
+public:
+	void test_copy_convert_matches_reference() {
+		static const int volumes[][2] = {
+			{ Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume },
+			{ 0, Audio::Mixer::kMaxMixerVolume },
+			{ 100, 37 },
+			{ 255, 1 }
+		};
+
+		for (uint i = 0; i < ARRAYSIZE(volumes); ++i) {
+			const int volL = volumes[i][0], volR = volumes[i][1];
+			checkCopyConvert(true, true, true, volL, volR);
+			checkCopyConvert(true, true, false, volL, volR);
+			checkCopyConvert(true, false, false, volL, volR);
+			checkCopyConvert(false, true, false, volL, volR);
+			checkCopyConvert(false, false, false, volL, volR);
+		}
+	}
+
+	void test_polyphase_upsample() {
+		const int inSamples = 11025;
+		Audio::SeekableAudioStream *stream = createToneStream(11025, 440, inSamples, 16000);
+		Audio::RateConverter *converter = Audio::makeRateConverter(11025, 44100, false, false, false, Audio::kRateConverterPolyphase);
+
+		int16 *out = new int16[inSamples * 4 + 1024];
+		int converted = convert(converter, stream, out, inSamples * 4 + 1024);
+
+		// Every input sample, including the ones still in the filter at the
+		// end of the stream, produces four output samples
+		TS_ASSERT_LESS_THAN_EQUALS(inSamples * 4, converted);
+		TS_ASSERT_LESS_THAN(converted, inSamples * 4 + 64);
+		TS_ASSERT(!converter->needsDraining());
+
+		// The filter delays the output by half its length; past that point
+		// it must follow the ideal upsampled tone closely
+		const int delay = 4 * 8;
+		double error = 0;
+		for (int i = 256; i < inSamples * 4 - 256; ++i) {
+			double expected = sin(2 * M_PI * 440 * (i - delay) / 44100.0) * 16000;
+			error += (out[i] - expected) * (out[i] - expected);
+		}
+		error = sqrt(error / (inSamples * 4 - 512));
+		TS_ASSERT_LESS_THAN(error, 32.0);
+
+		delete[] out;
+		delete converter;
+		delete stream;
+	}
+
+	void test_polyphase_downsample_filters_aliasing() {
+		// A tone above the output Nyquist frequency must be removed instead
+		// of folding back into the audible range
+		const int inSamples = 44100;
+		const int outSamples = inSamples * 22050 / 44100;
+		int16 *out = new int16[outSamples];
+
+		Audio::SeekableAudioStream *stream = createToneStream(44100, 15000, inSamples, 16000);
+		Audio::RateConverter *converter = Audio::makeRateConverter(44100, 22050, false, false, false, Audio::kRateConverterPolyphase);
+		convert(converter, stream, out, outSamples);
+		double filtered = rms(out + 64, outSamples - 128);
+		delete converter;
+		delete stream;
+
+		stream = createToneStream(44100, 15000, inSamples, 16000);
+		converter = Audio::makeRateConverter(44100, 22050, false, false, false);
+		convert(converter, stream, out, outSamples);
+		double aliased = rms(out + 64, outSamples - 128);
+		delete converter;
+		delete stream;
+
+		TS_ASSERT_LESS_THAN(filtered, 16000 * 0.05);
+		TS_ASSERT_LESS_THAN(filtered * 10, aliased);
+
+		delete[] out;
+	}
+
+	void test_polyphase_matches_reference() {
+		checkReference(22050, 32000);
+		checkReference(44100, 32000);
+		checkReference(11025, 44100);
+	}
+
+	void test_polyphase_dot_product() {
+		// The SIMD versions must give exactly the same result as the C one,
+		// also for the extreme values
+		int16 samples[Audio::POLYPHASE_TAPS + 3];
+		int16 coefs[Audio::POLYPHASE_TAPS + 5];
+		uint32 seed = 1;
+		for (int round = 0; round < 64; ++round) {
+			for (uint i = 0; i < ARRAYSIZE(samples); ++i) {
+				seed = seed * 1103515245 + 12345;
+				samples[i] = (round & 1) ? ((seed & 0x100) ? -32768 : 32767) : (int16)(seed >> 16);
+			}
+			for (uint i = 0; i < ARRAYSIZE(coefs); ++i) {
+				seed = seed * 1103515245 + 12345;
+				coefs[i] = (int16)((int)(seed >> 16) % 4096);
+			}
+
+			// Unaligned on purpose, like the filter history
+			const int16 *s = samples + (round % 4);
+			const int16 *c = coefs + (round % 6);
+			const int expected = Audio::polyphaseDotProductGeneric(s, c);
+#if defined(SCUMMVM_SSE2) && defined(__SSE2__)
+			TS_ASSERT_EQUALS(Audio::polyphaseDotProductSSE2(s, c), expected);
+#endif
+#if defined(SCUMMVM_NEON) && defined(__aarch64__)
+			TS_ASSERT_EQUALS(Audio::polyphaseDotProductNEON(s, c), expected);
+#endif
+			TS_ASSERT_EQUALS(Audio::getPolyphaseDotProduct()(s, c), expected);
+		}
+	}
+
+	void test_polyphase_stereo_rate_change() {
+		int16 samples[1024];
+		for (int i = 0; i < 512; ++i) {
+			samples[i * 2 + 0] = 1000;
+			samples[i * 2 + 1] = -2000;
+		}
+
+		Common::SeekableReadStream *s = new Common::MemoryReadStream((const byte *)samples, sizeof(samples), DisposeAfterUse::NO);
+		Audio::SeekableAudioStream *stream = Audio::makeRawStream(s, 22050, Audio::FLAG_16BITS | Audio::FLAG_STEREO
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                                          | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                                                         );
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 48000, true, true, false, Audio::kRateConverterPolyphase);
+
+		// A constant signal passes unchanged, also after changing the rate
+		int16 out[128 * 2];
+		memset(out, 0, sizeof(out));
+		TS_ASSERT_EQUALS(converter->convert(*stream, out, 128, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), 128);
+		TS_ASSERT_EQUALS(out[127 * 2 + 0], 1000);
+		TS_ASSERT_EQUALS(out[127 * 2 + 1], -2000);
+
+		converter->setInputRate(44100);
+		TS_ASSERT_EQUALS(converter->getInputRate(), 44100U);
+		memset(out, 0, sizeof(out));
+		TS_ASSERT_EQUALS(converter->convert(*stream, out, 128, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), 128);
+		TS_ASSERT_EQUALS(out[127 * 2 + 0], 1000);
+		TS_ASSERT_EQUALS(out[127 * 2 + 1], -2000);
+
+		delete converter;
+		delete stream;
+	}
+};
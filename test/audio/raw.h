@@ -11,7 +11,7 @@ private:
 	template<typename T>
 	void readBufferTestTemplate(const int sampleRate, const int time, const bool le, const bool isStereo) {
 		int16 *sine;
-		Audio::SeekableAudioStream *s = createSineStream<int8>(sampleRate, time, &sine, le, isStereo);
+		Audio::SeekableAudioStream *s = createSineStream<T>(sampleRate, time, &sine, le, isStereo);
 
 		const int totalSamples = sampleRate * time * (isStereo ? 2 : 1);
 		int16 *buffer = new int16[totalSamples];
@@ -0,0 +1,71 @@
+#include <cxxtest/TestSuite.h>
+
+#include "backends/fs/posix/posix-iostream.h"
+
+// <sys/stat.h> declares mkdir, which common/forbidden.h turns into a macro
+#undef mkdir
+#define mkdir FAKE_mkdir
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#undef mkdir
+#define mkdir(a,b) FORBIDDEN_look_at_common_forbidden_h_for_more_info SYMBOL !%*
+
+class PosixIoStreamTestSuite : public CxxTest::TestSuite {
+	static const uint32 kFileSize = 256 * 1024;
+
+	static bool writeFile(const char *path, uint32 size, byte seed) {
+		PosixIoStream *file = PosixIoStream::makeFromPath(path, true);
+		if (!file)
+			return false;
+
+		byte buffer[1024];
+		for (uint32 pos = 0; pos < size; pos += sizeof(buffer)) {
+			for (uint32 i = 0; i < sizeof(buffer); i++)
+				buffer[i] = (byte)((pos + i) * 13 + seed);
+			file->write(buffer, MIN<uint32>(sizeof(buffer), size - pos));
+		}
+
+		bool ok = file->flush() && !file->err();
+		delete file;
+		return ok;
+	}
+
+public:
+	void test_mmap_read() {
+		const char *path = "posix_iostream_test.bin";
+		TS_ASSERT(writeFile(path, kFileSize, 1));
+		chmod(path, 0444);
+
+		PosixMmapStream *stream = PosixMmapStream::makeFromPath(path);
+		TS_ASSERT(stream);
+		if (!stream) {
+			remove(path);
+			return;
+		}
+
+		TS_ASSERT_EQUALS(stream->size(), kFileSize);
+		TS_ASSERT(stream->seek(kFileSize - 2));
+		TS_ASSERT_EQUALS(stream->readByte(), (byte)((kFileSize - 2) * 13 + 1));
+		TS_ASSERT_EQUALS(stream->readByte(), (byte)((kFileSize - 1) * 13 + 1));
+		TS_ASSERT(!stream->eos());
+		stream->readByte();
+		TS_ASSERT(stream->eos());
+
+		delete stream;
+		remove(path);
+	}
+
+	void test_writable_file_is_not_mapped() {
+		const char *path = "posix_iostream_test.bin";
+		TS_ASSERT(writeFile(path, kFileSize, 1));
+		chmod(path, 0644);
+
+		// Truncating a mapped file would make reading it raise SIGBUS, so
+		// files which can be written to are read through stdio
+		struct statvfs fs;
+		if (statvfs(path, &fs) == 0 && !(fs.f_flag & ST_RDONLY))
+			TS_ASSERT(!PosixMmapStream::makeFromPath(path));
+
+		remove(path);
+	}
+};
@@ -0,0 +1,153 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flathashmap.h"
+#include "common/hash-str.h"
+
+// Counts the key comparisons, which is how long the probe sequences are
+struct FlatHashMapCountingEqualTo {
+	static uint _calls;
+	bool operator()(uint x, uint y) const { _calls++; return x == y; }
+};
+
+uint FlatHashMapCountingEqualTo::_calls = 0;
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	private:
+	// Returns the number of key comparisons needed to look up every key
+	static uint countLookupCompares(uint count, uint shift, uint offset) {
+		Common::FlatHashMap<uint, uint, Common::Hash<uint>, FlatHashMapCountingEqualTo> container;
+		for (uint i = 0; i < count; ++i)
+			container[offset + (i << shift)] = i;
+
+		FlatHashMapCountingEqualTo::_calls = 0;
+		for (uint i = 0; i < count; ++i)
+			TS_ASSERT_EQUALS(container.getValOrDefault(offset + (i << shift), count), i);
+		return FlatHashMapCountingEqualTo::_calls;
+	}
+
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		Common::FlatHashMap<Common::String, Common::String> container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> container;
+		container["foo"] = "bar";
+		container["quux"] = "blub";
+		TS_ASSERT(container.contains("foo"));
+		TS_ASSERT(container.contains("QUUX"));
+		TS_ASSERT(!container.contains("bar"));
+		TS_ASSERT(!container.contains("asdf"));
+		TS_ASSERT_EQUALS(container.getVal("FOO"), "bar");
+	}
+
+	void test_add_remove_iterator() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		TS_ASSERT(container.contains(1));
+		container.erase(container.find(1));
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT_EQUALS(container[1], 42);
+		container.erase(0);
+		container.erase(1);
+		container.erase(2);
+		TS_ASSERT(container.empty());
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(0), 17);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17, -10), -10);
+
+		int val = 0;
+		TS_ASSERT(containerRef.tryGetVal(1, val));
+		TS_ASSERT_EQUALS(val, -1);
+		TS_ASSERT(!containerRef.tryGetVal(2, val));
+	}
+
+	void test_iterator() {
+		Common::FlatHashMap<int, int> container;
+		for (int i = 0; i < 5; ++i)
+			container[i] = i * 10;
+		container.erase(1);
+		container.erase(3);
+
+		int found = 0;
+		Common::FlatHashMap<int, int>::const_iterator i;
+		for (i = container.begin(); i != container.end(); ++i) {
+			int key = i->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			TS_ASSERT_EQUALS(i->_value, key * 10);
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+4+1);
+	}
+
+	void test_matches_hashmap() {
+		// Drive both maps through enough inserts and erases to make the
+		// flat map grow and reuse deleted slots, and compare them.
+		Common::FlatHashMap<uint, uint> flat;
+		Common::HashMap<uint, uint> ref;
+		uint32 seed = 1;
+		for (int i = 0; i < 20000; ++i) {
+			seed = seed * 1103515245 + 12345;
+			const uint key = (seed >> 16) % 2000;
+			if (seed & 0x100) {
+				flat.erase(key);
+				ref.erase(key);
+			} else {
+				flat[key] = i;
+				ref[key] = i;
+			}
+		}
+
+		TS_ASSERT_EQUALS(flat.size(), ref.size());
+		for (Common::HashMap<uint, uint>::const_iterator j = ref.begin(); j != ref.end(); ++j)
+			TS_ASSERT_EQUALS(flat.getValOrDefault(j->_key, 0xFFFFFFFF), j->_value);
+
+		uint count = 0;
+		for (Common::FlatHashMap<uint, uint>::const_iterator j = flat.begin(); j != flat.end(); ++j, ++count)
+			TS_ASSERT(ref.contains(j->_key));
+		TS_ASSERT_EQUALS(count, ref.size());
+
+		Common::FlatHashMap<uint, uint> copy(flat);
+		TS_ASSERT_EQUALS(copy.size(), flat.size());
+		for (Common::HashMap<uint, uint>::const_iterator j = ref.begin(); j != ref.end(); ++j)
+			TS_ASSERT_EQUALS(copy.getValOrDefault(j->_key, 0xFFFFFFFF), j->_value);
+	}
+
+	void test_high_bit_keys() {
+		// Keys that only differ in their high bits must not share a probe
+		// sequence, or every lookup would compare against most of the keys.
+		// A few false tag matches are expected.
+		TS_ASSERT_LESS_THAN(countLookupCompares(1000, 0, 0), 1100u);
+		TS_ASSERT_LESS_THAN(countLookupCompares(1000, 12, 0x10000000), 1100u);
+		TS_ASSERT_LESS_THAN(countLookupCompares(1000, 20, 0), 1100u);
+	}
+};
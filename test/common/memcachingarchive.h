@@ -0,0 +1,138 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/stream.h"
+#include "../null_osystem.h"
+
+class TestMemcachingArchive : public Common::MemcachingCaseInsensitiveArchive {
+public:
+	TestMemcachingArchive(byte fill, uint32 maxStronglyCachedSize, uint32 maxStronglyCachedTotal) :
+		Common::MemcachingCaseInsensitiveArchive(maxStronglyCachedSize, maxStronglyCachedTotal), _fill(fill), _reads(0) {}
+
+	bool hasFile(const Common::Path &path) const override {
+		return path.toString().hasPrefix("file");
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		return 0;
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		return Common::ArchiveMemberPtr();
+	}
+
+	// Members are named "file<size>" and filled with _fill
+	Common::SharedArchiveContents readContentsForPath(const Common::Path &path) const override {
+		if (!hasFile(path))
+			return Common::SharedArchiveContents();
+
+		_reads++;
+		uint32 size = atoi(path.toString().c_str() + 4);
+		byte *contents = new byte[size];
+		memset(contents, _fill, size);
+		return Common::SharedArchiveContents(contents, size);
+	}
+
+	byte _fill;
+	mutable int _reads;
+};
+
+class MemcachingArchiveTestSuite : public CxxTest::TestSuite {
+public:
+	void test_small_contents_are_cached() {
+		TestMemcachingArchive archive(1, 512, 1024);
+
+		delete archive.createReadStreamForMember("file100");
+		delete archive.createReadStreamForMember("file100");
+		TS_ASSERT_EQUALS(archive._reads, 1);
+		TS_ASSERT_EQUALS(archive.getCacheStats().hits, 1U);
+		TS_ASSERT_EQUALS(archive.getCacheStats().misses, 1U);
+		TS_ASSERT_EQUALS(archive.getCacheStats().cachedBytes, 100U);
+
+		TS_ASSERT(!archive.createReadStreamForMember("missing"));
+	}
+
+	void test_big_contents_are_not_kept() {
+		TestMemcachingArchive archive(1, 512, 1024);
+
+		Common::SeekableReadStream *stream = archive.createReadStreamForMember("file1000");
+		TS_ASSERT_EQUALS(stream->size(), 1000);
+
+		// Still in use by the first stream
+		Common::SeekableReadStream *stream2 = archive.createReadStreamForMember("file1000");
+		TS_ASSERT_EQUALS(archive._reads, 1);
+		delete stream;
+		delete stream2;
+		TS_ASSERT_EQUALS(archive.getCacheStats().cachedBytes, 0U);
+
+		delete archive.createReadStreamForMember("file1000");
+		TS_ASSERT_EQUALS(archive._reads, 2);
+	}
+
+	void test_budget_evicts_least_recently_used() {
+		TestMemcachingArchive archive(1, 512, 1000);
+
+		delete archive.createReadStreamForMember("file400");
+		delete archive.createReadStreamForMember("file401");
+		delete archive.createReadStreamForMember("file400");
+		TS_ASSERT_EQUALS(archive.getCacheStats().cachedBytes, 801U);
+
+		// file401 is the least recently used one
+		delete archive.createReadStreamForMember("file402");
+		TS_ASSERT_EQUALS(archive.getCacheStats().evictions, 1U);
+		TS_ASSERT_EQUALS(archive.getCacheStats().cachedBytes, 802U);
+
+		archive._reads = 0;
+		delete archive.createReadStreamForMember("file400");
+		delete archive.createReadStreamForMember("file402");
+		TS_ASSERT_EQUALS(archive._reads, 0);
+		delete archive.createReadStreamForMember("file401");
+		TS_ASSERT_EQUALS(archive._reads, 1);
+		TS_ASSERT(archive.getCacheStats().cachedBytes <= 1000U);
+	}
+
+	void test_same_source_shares_contents() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The registry of shared contents is guarded by a mutex
+		Common::install_null_g_system();
+
+		TestMemcachingArchive archive1(7, 512, 1024);
+		TestMemcachingArchive archive2(8, 512, 1024);
+		TestMemcachingArchive archive3(9, 512, 1024);
+		TestMemcachingArchive archive4(10, 512, 1024);
+		archive1.setSharedContentsSource("source");
+		archive2.setSharedContentsSource("source");
+		archive3.setSharedContentsSource("other");
+
+		Common::SeekableReadStream *stream1 = archive1.createReadStreamForMember("file10000");
+		Common::SeekableReadStream *stream2 = archive2.createReadStreamForMember("FILE10000");
+		Common::SeekableReadStream *stream3 = archive3.createReadStreamForMember("file10000");
+		Common::SeekableReadStream *stream4 = archive4.createReadStreamForMember("file10000");
+
+		// The second archive did not read the member itself
+		TS_ASSERT_EQUALS(archive2._reads, 0);
+		TS_ASSERT_EQUALS(archive2.getCacheStats().sharedContents, 1U);
+		TS_ASSERT_EQUALS(archive2.getCacheStats().misses, 0U);
+		TS_ASSERT_EQUALS(archive3._reads, 1);
+		TS_ASSERT_EQUALS(archive4._reads, 1);
+
+		byte value;
+		stream2->seek(9999);
+		stream2->read(&value, 1);
+		TS_ASSERT_EQUALS(value, 7);
+		stream3->read(&value, 1);
+		TS_ASSERT_EQUALS(value, 9);
+		stream4->read(&value, 1);
+		TS_ASSERT_EQUALS(value, 10);
+
+		delete stream1;
+		delete stream2;
+		delete stream3;
+		delete stream4;
+
+		// Nothing uses the contents anymore, so they are read again
+		delete archive2.createReadStreamForMember("file10000");
+		TS_ASSERT_EQUALS(archive2._reads, 1);
+#endif
+	}
+};
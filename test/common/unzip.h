@@ -0,0 +1,184 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/compression/unzip.h"
+#include "common/crc.h"
+#include "common/memstream.h"
+
+class UnzipTestSuite : public CxxTest::TestSuite {
+private:
+	struct ZipMember {
+		const char *name;
+		uint16 method;
+		const byte *data;
+		uint32 size;
+		uint32 crc;
+	};
+
+	static byte *makeContents(uint32 size, byte seed) {
+		byte *data = new byte[size];
+		for (uint32 i = 0; i < size; i++)
+			data[i] = (byte)(i * 7 + (i >> 9) + seed);
+		return data;
+	}
+
+	// Raw DEFLATE data made of uncompressed blocks
+	static Common::MemoryWriteStreamDynamic *deflateStored(const byte *data, uint32 size) {
+		Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		uint32 pos = 0;
+		do {
+			const uint16 len = (uint16)MIN<uint32>(size - pos, 0xffff);
+			out->writeByte(pos + len == size ? 1 : 0);
+			out->writeUint16LE(len);
+			out->writeUint16LE(~len);
+			out->write(data + pos, len);
+			pos += len;
+		} while (pos < size);
+		return out;
+	}
+
+	static Common::SeekableReadStream *makeZip(const ZipMember *members, uint count) {
+		Common::MemoryWriteStreamDynamic zip(DisposeAfterUse::NO);
+		Common::MemoryWriteStreamDynamic centralDir(DisposeAfterUse::YES);
+
+		for (uint i = 0; i < count; i++) {
+			const ZipMember &member = members[i];
+			const uint32 offset = zip.pos();
+			const uint16 nameLength = strlen(member.name);
+
+			const byte *compressed = member.data;
+			uint32 compressedSize = member.size;
+			Common::MemoryWriteStreamDynamic *deflated = nullptr;
+			if (member.method == 8) {
+				deflated = deflateStored(member.data, member.size);
+				compressed = deflated->getData();
+				compressedSize = deflated->size();
+			}
+
+			zip.writeUint32LE(0x04034b50);
+			zip.writeUint16LE(20);
+			zip.writeUint16LE(0);
+			zip.writeUint16LE(member.method);
+			zip.writeUint32LE(0);
+			zip.writeUint32LE(member.crc);
+			zip.writeUint32LE(compressedSize);
+			zip.writeUint32LE(member.size);
+			zip.writeUint16LE(nameLength);
+			zip.writeUint16LE(0);
+			zip.write(member.name, nameLength);
+			zip.write(compressed, compressedSize);
+
+			centralDir.writeUint32LE(0x02014b50);
+			centralDir.writeUint16LE(20);
+			centralDir.writeUint16LE(20);
+			centralDir.writeUint16LE(0);
+			centralDir.writeUint16LE(member.method);
+			centralDir.writeUint32LE(0);
+			centralDir.writeUint32LE(member.crc);
+			centralDir.writeUint32LE(compressedSize);
+			centralDir.writeUint32LE(member.size);
+			centralDir.writeUint16LE(nameLength);
+			centralDir.writeUint16LE(0);
+			centralDir.writeUint16LE(0);
+			centralDir.writeUint16LE(0);
+			centralDir.writeUint16LE(0);
+			centralDir.writeUint32LE(0);
+			centralDir.writeUint32LE(offset);
+			centralDir.write(member.name, nameLength);
+
+			delete deflated;
+		}
+
+		const uint32 centralDirOffset = zip.pos();
+		zip.write(centralDir.getData(), centralDir.size());
+
+		zip.writeUint32LE(0x06054b50);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(count);
+		zip.writeUint16LE(count);
+		zip.writeUint32LE(centralDir.size());
+		zip.writeUint32LE(centralDirOffset);
+		zip.writeUint16LE(0);
+
+		return new Common::MemoryReadStream(zip.getData(), zip.size(), DisposeAfterUse::YES);
+	}
+
+	static bool readsBack(Common::SeekableReadStream *stream, const byte *data, uint32 size) {
+		if (!stream || stream->size() != size)
+			return false;
+
+		byte *buffer = new byte[size];
+		bool ok = stream->read(buffer, size) == size && memcmp(buffer, data, size) == 0;
+		delete[] buffer;
+		return ok;
+	}
+
+public:
+	void test_streamed_members_outlive_archive() {
+		Common::CRC32 crc;
+		const uint32 storedSize = 100 * 1024;
+		const uint32 deflatedSize = 1536 * 1024;
+		byte *stored = makeContents(storedSize, 1);
+		byte *deflated = makeContents(deflatedSize, 2);
+
+		const ZipMember members[] = {
+			{ "stored.bin", 0, stored, storedSize, crc.crcFast(stored, storedSize) },
+			{ "deflated.bin", 8, deflated, deflatedSize, crc.crcFast(deflated, deflatedSize) }
+		};
+
+		Common::Archive *archive = Common::makeZipArchive(makeZip(members, ARRAYSIZE(members)));
+		TS_ASSERT(archive);
+		if (!archive)
+			return;
+
+		Common::SeekableReadStream *storedStream = archive->createReadStreamForMember("stored.bin");
+		Common::SeekableReadStream *deflatedStream = archive->createReadStreamForMember("deflated.bin");
+		delete archive;
+
+		TS_ASSERT(readsBack(storedStream, stored, storedSize));
+		TS_ASSERT(storedStream && !storedStream->err());
+		TS_ASSERT(readsBack(deflatedStream, deflated, deflatedSize));
+		TS_ASSERT(deflatedStream && !deflatedStream->err());
+
+		delete storedStream;
+		delete deflatedStream;
+		delete[] stored;
+		delete[] deflated;
+	}
+
+	void test_streamed_member_crc_mismatch() {
+		Common::CRC32 crc;
+		const uint32 size = 100 * 1024;
+		byte *data = makeContents(size, 3);
+
+		const ZipMember members[] = {
+			{ "bad.bin", 0, data, size, crc.crcFast(data, size) ^ 1 }
+		};
+
+		Common::Archive *archive = Common::makeZipArchive(makeZip(members, ARRAYSIZE(members)));
+		TS_ASSERT(archive);
+		if (!archive)
+			return;
+
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("bad.bin");
+		delete archive;
+
+		// The contents can be read, but the error shows once the end is reached
+		TS_ASSERT(stream);
+		if (stream) {
+			byte buffer[1024];
+			stream->read(buffer, sizeof(buffer));
+			TS_ASSERT(!stream->err());
+			TS_ASSERT(stream->seek(0, SEEK_END));
+			TS_ASSERT(!stream->err());
+			stream->seek(0);
+			while (!stream->eos() && stream->read(buffer, sizeof(buffer)) > 0)
+				;
+			TS_ASSERT(stream->err());
+		}
+
+		delete stream;
+		delete[] data;
+	}
+};
@@ -0,0 +1,118 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/dirtyregion.h"
+
+class DirtyRegionTestSuite : public CxxTest::TestSuite {
+public:
+	void test_empty() {
+		Graphics::DirtyRegion region;
+		region.setSize(320, 200, 16);
+		TS_ASSERT(region.isEmpty());
+		TS_ASSERT(!region.isFull());
+		TS_ASSERT_EQUALS(region.getStats().totalTiles, 20u * 13u);
+
+		Common::Array<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT(rects.empty());
+
+		// Rects outside the tracked area are ignored
+		region.addRect(Common::Rect(320, 0, 330, 10));
+		region.addRect(Common::Rect(-20, -20, -10, -10));
+		TS_ASSERT(region.isEmpty());
+		TS_ASSERT_EQUALS(region.getStats().addedRects, 0u);
+	}
+
+	void test_tile_alignment() {
+		Graphics::DirtyRegion region;
+		region.setSize(320, 200, 16);
+		region.addRect(Common::Rect(17, 3, 20, 5));
+		region.addRect(Common::Rect(310, 195, 320, 200));
+
+		Common::Array<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 2u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(16, 0, 32, 16));
+		// The last tile row and column are clipped to the tracked area
+		TS_ASSERT_EQUALS(rects[1], Common::Rect(304, 192, 320, 200));
+		TS_ASSERT_EQUALS(region.getBoundingRect(), Common::Rect(16, 0, 320, 200));
+
+		const Graphics::DirtyRegion::Stats &stats = region.getStats();
+		TS_ASSERT_EQUALS(stats.addedRects, 2u);
+		TS_ASSERT_EQUALS(stats.dirtyTiles, 2u);
+		TS_ASSERT_EQUALS(stats.outputRects, 2u);
+		TS_ASSERT_EQUALS(stats.outputArea, 16u * 16u + 16u * 8u);
+	}
+
+	void test_merge_runs() {
+		Graphics::DirtyRegion region;
+		region.setSize(128, 128, 16);
+
+		// Overlapping rects forming one block of 3x4 tiles
+		region.addRect(Common::Rect(0, 0, 40, 40));
+		region.addRect(Common::Rect(20, 30, 48, 64));
+		region.addRect(Common::Rect(0, 40, 10, 64));
+
+		Common::Array<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 0, 48, 64));
+		TS_ASSERT_EQUALS(region.getStats().dirtyTiles, 12u);
+
+		// Separate columns stay separate
+		region.clear();
+		region.addRect(Common::Rect(0, 0, 16, 128));
+		region.addRect(Common::Rect(64, 0, 80, 128));
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 2u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 0, 16, 128));
+		TS_ASSERT_EQUALS(rects[1], Common::Rect(64, 0, 80, 128));
+	}
+
+	void test_max_rects() {
+		Graphics::DirtyRegion region;
+		region.setSize(256, 256, 16);
+
+		// A checkerboard of 128 separate tiles
+		for (int y = 0; y < 16; y++)
+			for (int x = y & 1; x < 16; x += 2)
+				region.addRect(Common::Rect(x * 16, y * 16, x * 16 + 1, y * 16 + 1));
+		TS_ASSERT_EQUALS(region.getStats().dirtyTiles, 128u);
+
+		Common::Array<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 128u);
+
+		region.getRects(rects, 10);
+		TS_ASSERT_LESS_THAN_EQUALS(rects.size(), 10u);
+
+		// Every dirty tile is still covered
+		for (int y = 0; y < 16; y++) {
+			for (int x = y & 1; x < 16; x += 2) {
+				bool covered = false;
+				for (uint i = 0; i < rects.size(); i++)
+					covered = covered || rects[i].contains(Common::Rect(x * 16, y * 16, x * 16 + 16, y * 16 + 16));
+				TS_ASSERT(covered);
+			}
+		}
+
+		region.getRects(rects, 1);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 0, 256, 256));
+	}
+
+	void test_mark_all() {
+		Graphics::DirtyRegion region;
+		region.setSize(100, 50, 32);
+		region.markAll();
+		TS_ASSERT(region.isFull());
+
+		Common::Array<Common::Rect> rects;
+		region.getRects(rects, 4);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 0, 100, 50));
+
+		region.clear();
+		TS_ASSERT(region.isEmpty());
+		TS_ASSERT_EQUALS(region.getStats().addedRects, 0u);
+	}
+};
@@ -0,0 +1,78 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/random.h"
+
+#ifdef USE_TINYGL
+#include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/zspan.h"
+#endif
+
+class TinyGLDepthSpanTestSuite : public CxxTest::TestSuite {
+#ifdef USE_TINYGL
+	static const int kMaxCount = 45;
+
+	static void checkSpans(TinyGL::Internal::DepthSpanFunc func, const char *name) {
+		static const int depthFuncs[] = {
+			TGL_NEVER, TGL_LESS, TGL_EQUAL, TGL_LEQUAL, TGL_GREATER, TGL_NOTEQUAL, TGL_GEQUAL, TGL_ALWAYS
+		};
+
+		Common::RandomSource rnd("tinygl_zspan");
+		uint expectedZ[kMaxCount + 1], actualZ[kMaxCount + 1];
+		byte expectedMask[kMaxCount], actualMask[kMaxCount];
+
+		for (int round = 0; round < 400; round++) {
+			// Cover every remainder of the vector loops, unaligned buffers,
+			// both slopes, and depths on both sides of the sign bit
+			const int count = round % (kMaxCount + 1);
+			const int offset = (round / (kMaxCount + 1)) & 1;
+			const int dzdx = (int)rnd.getRandomNumber(0x1FFFF) - 0x10000;
+			const uint z = (round & 2) ? 0x80000000u - count * 0x8000 + rnd.getRandomNumber(0xFFFF) : rnd.getRandomNumber(0xFFFFFFFF);
+
+			uint pixelZ = z;
+			for (int i = 0; i < count; i++, pixelZ += dzdx) {
+				// Depths equal to, just below and just above the span
+				const int delta = (int)rnd.getRandomNumber(2) - 1;
+				expectedZ[offset + i] = pixelZ + delta * (int)rnd.getRandomNumber(0xFFFF);
+			}
+
+			for (int f = 0; f < ARRAYSIZE(depthFuncs); f++) {
+				for (int depthWrite = 0; depthWrite < 2; depthWrite++) {
+					uint reference[kMaxCount + 1];
+					memcpy(reference, expectedZ, sizeof(reference));
+					memcpy(actualZ, expectedZ, sizeof(actualZ));
+					memset(expectedMask, 0x55, sizeof(expectedMask));
+					memset(actualMask, 0x55, sizeof(actualMask));
+
+					TinyGL::Internal::depthSpanGeneric(reference + offset, z, dzdx, count, depthFuncs[f], depthWrite, expectedMask);
+					func(actualZ + offset, z, dzdx, count, depthFuncs[f], depthWrite, actualMask);
+
+					TSM_ASSERT_SAME_DATA(name, actualZ, reference, sizeof(reference));
+					TSM_ASSERT_SAME_DATA(name, actualMask, expectedMask, sizeof(expectedMask));
+				}
+			}
+		}
+	}
+#endif
+
+public:
+	void test_sse2_matches_generic() {
+#if defined(USE_TINYGL) && defined(SCUMMVM_SSE2)
+		if (instrset_detect() >= 2)
+			checkSpans(TinyGL::Internal::depthSpanSSE2, "SSE2");
+#endif
+	}
+
+	void test_avx2_matches_generic() {
+#if defined(USE_TINYGL) && defined(SCUMMVM_AVX2)
+		if (instrset_detect() >= 8)
+			checkSpans(TinyGL::Internal::depthSpanAVX2, "AVX2");
+#endif
+	}
+
+	void test_neon_matches_generic() {
+#if defined(USE_TINYGL) && defined(SCUMMVM_NEON)
+		checkSpans(TinyGL::Internal::depthSpanNEON, "NEON");
+#endif
+	}
+};
@@ -0,0 +1,97 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/file.h"
+#include "graphics/font.h"
+#include "graphics/fonts/ttf.h"
+#include "graphics/surface.h"
+#include "../null_osystem.h"
+
+// The font file is read through the null OSystem
+#if defined(USE_FREETYPE2) && NULL_OSYSTEM_IS_AVAILABLE
+#define TEST_TTF 1
+#else
+#define TEST_TTF 0
+#endif
+
+class TTFTestSuite : public CxxTest::TestSuite {
+#if TEST_TTF
+private:
+	static Graphics::Font *loadFont(int size) {
+		Common::File file;
+		if (!file.open("LiberationSans-Regular.ttf"))
+			return nullptr;
+		return Graphics::loadTTFFont(file, size);
+	}
+
+	static void drawText(const Graphics::Font *font, Graphics::Surface &surface) {
+		surface.create(200, 40, Graphics::PixelFormat::createFormatCLUT8());
+		font->drawString(&surface, "Sphinx of black quartz", 2, 2, 196, 255);
+	}
+#endif
+
+public:
+	void test_instances_share_glyphs() {
+#if TEST_TTF
+		Common::install_null_g_system();
+
+		const Graphics::TTFGlyphAtlasStats before = Graphics::getTTFGlyphAtlasStats();
+
+		Graphics::Font *first = loadFont(14);
+		TS_ASSERT(first);
+		if (!first)
+			return;
+
+		Graphics::Surface firstText;
+		drawText(first, firstText);
+		const Graphics::TTFGlyphAtlasStats withFirst = Graphics::getTTFGlyphAtlasStats();
+		TS_ASSERT_EQUALS(withFirst.fonts, before.fonts + 1);
+		TS_ASSERT_LESS_THAN(before.glyphs, withFirst.glyphs);
+
+		// A second instance of the same font reuses the glyphs of the first
+		Graphics::Font *second = loadFont(14);
+		TS_ASSERT(second);
+		Graphics::Surface secondText;
+		if (second)
+			drawText(second, secondText);
+		const Graphics::TTFGlyphAtlasStats withSecond = Graphics::getTTFGlyphAtlasStats();
+		TS_ASSERT_EQUALS(withSecond.fonts, withFirst.fonts);
+		TS_ASSERT_EQUALS(withSecond.glyphs, withFirst.glyphs);
+		TS_ASSERT_EQUALS(withSecond.usedBytes, withFirst.usedBytes);
+		if (second)
+			TS_ASSERT_SAME_DATA(firstText.getPixels(), secondText.getPixels(), firstText.pitch * firstText.h);
+
+		// The glyphs stay as long as one instance is alive
+		delete first;
+		TS_ASSERT_EQUALS(Graphics::getTTFGlyphAtlasStats().glyphs, withFirst.glyphs);
+		delete second;
+		const Graphics::TTFGlyphAtlasStats after = Graphics::getTTFGlyphAtlasStats();
+		TS_ASSERT_EQUALS(after.fonts, before.fonts);
+		TS_ASSERT_EQUALS(after.glyphs, before.glyphs);
+
+		// Pages left without glyphs are freed right away
+		TS_ASSERT_EQUALS(after.pages, before.pages);
+		TS_ASSERT_EQUALS(after.usedBytes, before.usedBytes);
+
+		firstText.free();
+		secondText.free();
+#endif
+	}
+
+	void test_sizes_do_not_share_glyphs() {
+#if TEST_TTF
+		Common::install_null_g_system();
+
+		const Graphics::TTFGlyphAtlasStats before = Graphics::getTTFGlyphAtlasStats();
+
+		Graphics::Font *small = loadFont(12);
+		Graphics::Font *large = loadFont(16);
+		TS_ASSERT(small);
+		TS_ASSERT(large);
+		TS_ASSERT_EQUALS(Graphics::getTTFGlyphAtlasStats().fonts, before.fonts + 2);
+
+		delete small;
+		delete large;
+		TS_ASSERT_EQUALS(Graphics::getTTFGlyphAtlasStats().fonts, before.fonts);
+#endif
+	}
+};
@@ -0,0 +1,162 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/random.h"
+#include "common/system.h"
+
+#include "graphics/yuv_to_rgb_rows.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 256 + 22;
+	static const int kHeight = 256;
+
+	byte _y[kWidth * kHeight], _u[kWidth * kHeight], _v[kWidth * kHeight], _a[kWidth * kHeight];
+
+	void fillPlanes() {
+		Common::RandomSource rnd("yuv_to_rgb");
+		// Cover every chroma pair, with random luma and the luma extremes
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				int i = y * kWidth + x;
+				_u[i] = y;
+				_v[i] = x;
+				_y[i] = (x % 7 == 0) ? 0 : (x % 7 == 1) ? 255 : rnd.getRandomNumber(255);
+				_a[i] = rnd.getRandomNumber(255);
+			}
+		}
+	}
+
+	void checkRows(const Graphics::YUVToRGBRowFuncs &funcs, const char *name) {
+		static const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0)
+		};
+
+		Graphics::YUVToRGBRowFuncs generic;
+		Graphics::initYUVToRGBRowsGeneric(generic);
+
+		uint32 expected[kWidth], actual[kWidth];
+
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			for (int scale = 0; scale < 2; scale++) {
+				Graphics::YUVToRGBLookup lookup(formats[f], scale ? Graphics::YUVToRGBManager::kScaleITU : Graphics::YUVToRGBManager::kScaleFull);
+				const Graphics::YUVToRGBRowParams &params = lookup.getRowParams();
+				const bool is32Bit = formats[f].bytesPerPixel == 4;
+
+				for (int variant = 0; variant < 4; variant++) {
+					const bool half = (variant & 1);
+					const byte *alpha = (variant & 2) ? _a : nullptr;
+					Graphics::YUVToRGBRowFunc ref = half ? (is32Bit ? generic.half32 : generic.half16) : (is32Bit ? generic.full32 : generic.full16);
+					Graphics::YUVToRGBRowFunc test = half ? (is32Bit ? funcs.half32 : funcs.half16) : (is32Bit ? funcs.full32 : funcs.full16);
+
+					for (int y = 0; y < kHeight; y++) {
+						// Odd widths exercise the tail handling
+						int width = half ? kWidth - 2 * (y % 8) : kWidth - (y % 17);
+						int offset = y * kWidth;
+
+						ref((byte *)expected, _y + offset, _u + offset, _v + offset, alpha ? alpha + offset : nullptr, width, params);
+						test((byte *)actual, _y + offset, _u + offset, _v + offset, alpha ? alpha + offset : nullptr, width, params);
+
+						if (memcmp(expected, actual, width * formats[f].bytesPerPixel) != 0) {
+							TS_FAIL(Common::String::format("%s differs: format %s, scale %d, variant %d, row %d",
+								name, formats[f].toString().c_str(), scale, variant, y).c_str());
+							return;
+						}
+					}
+				}
+			}
+		}
+	}
+
+public:
+	void test_simd_rows_match_generic() {
+		fillPlanes();
+		Graphics::YUVToRGBRowFuncs funcs;
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			Graphics::initYUVToRGBRowsSSE2(funcs);
+			checkRows(funcs, "SSE2");
+		}
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8) {
+			Graphics::initYUVToRGBRowsAVX2(funcs);
+			checkRows(funcs, "AVX2");
+		}
+#endif
+		(void)funcs;
+	}
+
+	void test_convert_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		const int width = 640, height = 480;
+		byte *yPlane = new byte[width * height];
+		byte *uPlane = new byte[width * height / 4];
+		byte *vPlane = new byte[width * height / 4];
+		for (int i = 0; i < width * height; i++)
+			yPlane[i] = i * 7;
+		for (int i = 0; i < width * height / 4; i++) {
+			uPlane[i] = i * 3;
+			vPlane[i] = i * 5;
+		}
+
+		Graphics::Surface surface;
+		surface.create(width, height, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+
+		Graphics::YUVToRGBLookup lookup(surface.format, Graphics::YUVToRGBManager::kScaleITU);
+		Graphics::YUVToRGBRowFuncs generic, funcs;
+		Graphics::initYUVToRGBRowsGeneric(generic);
+		Graphics::initYUVToRGBRowsGeneric(funcs);
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			Graphics::initYUVToRGBRowsSSE2(funcs);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			Graphics::initYUVToRGBRowsAVX2(funcs);
+#endif
+
+#ifdef SLOW_TESTS
+		const int iters = 500;
+#else
+		const int iters = 1;
+#endif
+
+		uint32 genericStart = g_system->getMillis();
+		for (int i = 0; i < iters; i++) {
+			for (int y = 0; y < height; y++)
+				generic.half32((byte *)surface.getBasePtr(0, y), yPlane + y * width, uPlane + (y / 2) * (width / 2), vPlane + (y / 2) * (width / 2), nullptr, width, lookup.getRowParams());
+		}
+		uint32 genericTime = g_system->getMillis() - genericStart;
+
+		uint32 newStart = g_system->getMillis();
+		for (int i = 0; i < iters; i++) {
+			for (int y = 0; y < height; y++)
+				funcs.half32((byte *)surface.getBasePtr(0, y), yPlane + y * width, uPlane + (y / 2) * (width / 2), vPlane + (y / 2) * (width / 2), nullptr, width, lookup.getRowParams());
+		}
+		uint32 newTime = g_system->getMillis() - newStart;
+
+		debug("YUV420 to RGB (non SIMD) time for %d %dx%d frames (in milliseconds): %d\n", iters, width, height, genericTime);
+		debug("YUV420 to RGB time for %d %dx%d frames (in milliseconds): %d\n", iters, width, height, newTime);
+
+		surface.free();
+		delete[] yPlane;
+		delete[] uPlane;
+		delete[] vPlane;
+#endif
+	}
+};
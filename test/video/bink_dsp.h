@@ -0,0 +1,98 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/random.h"
+
+#include "video/bink_dsp.h"
+
+class BinkDSPTestSuite : public CxxTest::TestSuite {
+#ifdef USE_BINK
+	static const int kPitch = 8 * 3 + 5;
+
+	// Dense blocks, DC only blocks, and blocks with only the first row or
+	// column set, which take the shortcuts of the transforms
+	static void fillCoefficients(Common::RandomSource &rnd, int round, int32 *block) {
+		for (int i = 0; i < 64; i++) {
+			bool used;
+			switch (round % 4) {
+			case 0:
+				used = true;
+				break;
+			case 1:
+				used = (i == 0);
+				break;
+			case 2:
+				used = (i < 8);
+				break;
+			default:
+				used = ((i & 7) == 0);
+				break;
+			}
+			block[i] = used ? (int32)rnd.getRandomNumber(8191) - 4096 : 0;
+		}
+	}
+
+	static void fillPixels(Common::RandomSource &rnd, byte *pixels) {
+		for (int i = 0; i < 8 * kPitch; i++)
+			pixels[i] = rnd.getRandomNumber(255);
+	}
+
+	void checkKernels(const Video::BinkDSP &dsp, const char *name) {
+		Video::BinkDSP generic;
+		Video::initBinkDSPGeneric(generic);
+
+		Common::RandomSource rnd("bink_dsp");
+		int32 coefs[64], expectedBlock[64], actualBlock[64];
+		int16 residue[64];
+		byte expected[8 * kPitch], actual[8 * kPitch];
+
+		for (int round = 0; round < 2000; round++) {
+			fillCoefficients(rnd, round, coefs);
+
+			memcpy(expectedBlock, coefs, sizeof(coefs));
+			memcpy(actualBlock, coefs, sizeof(coefs));
+			generic.idct(expectedBlock);
+			dsp.idct(actualBlock);
+			TSM_ASSERT_SAME_DATA(name, actualBlock, expectedBlock, sizeof(expectedBlock));
+
+			fillPixels(rnd, expected);
+			memcpy(actual, expected, sizeof(actual));
+			memcpy(expectedBlock, coefs, sizeof(coefs));
+			memcpy(actualBlock, coefs, sizeof(coefs));
+			generic.idctPut(expected, kPitch, expectedBlock);
+			dsp.idctPut(actual, kPitch, actualBlock);
+			TSM_ASSERT_SAME_DATA(name, actual, expected, sizeof(expected));
+
+			fillPixels(rnd, expected);
+			memcpy(actual, expected, sizeof(actual));
+			memcpy(expectedBlock, coefs, sizeof(coefs));
+			memcpy(actualBlock, coefs, sizeof(coefs));
+			generic.idctAdd(expected, kPitch, expectedBlock);
+			dsp.idctAdd(actual, kPitch, actualBlock);
+			TSM_ASSERT_SAME_DATA(name, actual, expected, sizeof(expected));
+
+			// Residues wrap around like the reference decoder
+			for (int i = 0; i < 64; i++)
+				residue[i] = (int16)rnd.getRandomNumber(1023) - 512;
+			fillPixels(rnd, expected);
+			memcpy(actual, expected, sizeof(actual));
+			generic.addResidue(expected, kPitch, residue);
+			dsp.addResidue(actual, kPitch, residue);
+			TSM_ASSERT_SAME_DATA(name, actual, expected, sizeof(expected));
+		}
+	}
+#endif
+
+public:
+	void test_sse2_matches_generic() {
+#if defined(USE_BINK) && defined(SCUMMVM_SSE2)
+		if (instrset_detect() < 2)
+			return;
+
+		Video::BinkDSP dsp;
+		Video::initBinkDSPGeneric(dsp);
+		Video::initBinkDSPSSE2(dsp);
+		checkKernels(dsp, "SSE2");
+#endif
+	}
+};
@@ -0,0 +1,201 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef USE_BINK
+
+#include "video/bink_dsp.h"
+
+#include <emmintrin.h>
+
+#ifdef __GNUC__
+#pragma GCC push_options
+
+#ifndef __x86_64__
+#pragma GCC target("sse2")
+#endif
+
+#endif
+
+namespace Video {
+
+// SSE2 has no 32-bit multiply keeping the low half, build it out of two 32x32->64 ones
+static FORCEINLINE __m128i mulShift11(__m128i a, int32 c) {
+	const __m128i cv = _mm_set1_epi32(c);
+	__m128i even = _mm_shuffle_epi32(_mm_mul_epu32(a, cv), _MM_SHUFFLE(0, 0, 2, 0));
+	__m128i odd = _mm_shuffle_epi32(_mm_mul_epu32(_mm_srli_si128(a, 4), cv), _MM_SHUFFLE(0, 0, 2, 0));
+	return _mm_srai_epi32(_mm_unpacklo_epi32(even, odd), 11);
+}
+
+static FORCEINLINE void transpose4x4(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+	__m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	__m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	__m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	__m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+// Four 1D transforms side by side, one per lane. Mirrors IDCT_TRANSFORM.
+template<bool kRow>
+static FORCEINLINE void transform(__m128i *d, const __m128i *s) {
+	const __m128i a0 = _mm_add_epi32(s[0], s[4]);
+	const __m128i a1 = _mm_sub_epi32(s[0], s[4]);
+	const __m128i a2 = _mm_add_epi32(s[2], s[6]);
+	const __m128i a3 = mulShift11(_mm_sub_epi32(s[2], s[6]), 2896);
+	const __m128i a4 = _mm_add_epi32(s[5], s[3]);
+	const __m128i a5 = _mm_sub_epi32(s[5], s[3]);
+	const __m128i a6 = _mm_add_epi32(s[1], s[7]);
+	const __m128i a7 = _mm_sub_epi32(s[1], s[7]);
+	const __m128i b0 = _mm_add_epi32(a4, a6);
+	const __m128i b1 = mulShift11(_mm_add_epi32(a5, a7), 3784);
+	const __m128i b2 = _mm_add_epi32(_mm_sub_epi32(mulShift11(a5, -5352), b0), b1);
+	const __m128i b3 = _mm_sub_epi32(mulShift11(_mm_sub_epi32(a6, a4), 2896), b2);
+	const __m128i b4 = _mm_sub_epi32(_mm_add_epi32(mulShift11(a7, 2217), b3), b1);
+
+	const __m128i e0 = _mm_add_epi32(a0, a2);
+	const __m128i e1 = _mm_sub_epi32(a0, a2);
+	const __m128i e2 = _mm_sub_epi32(_mm_add_epi32(a1, a3), a2);
+	const __m128i e3 = _mm_add_epi32(_mm_sub_epi32(a1, a3), a2);
+
+	d[0] = _mm_add_epi32(e0, b0);
+	d[1] = _mm_add_epi32(e2, b2);
+	d[2] = _mm_add_epi32(e3, b3);
+	d[3] = _mm_sub_epi32(e1, b4);
+	d[4] = _mm_add_epi32(e1, b4);
+	d[5] = _mm_sub_epi32(e3, b3);
+	d[6] = _mm_sub_epi32(e2, b2);
+	d[7] = _mm_sub_epi32(e0, b0);
+
+	if (kRow) {
+		const __m128i round = _mm_set1_epi32(0x7F);
+		for (int i = 0; i < 8; i++)
+			d[i] = _mm_srai_epi32(_mm_add_epi32(d[i], round), 8);
+	}
+}
+
+/**
+ * Full 2D transform. On return, rows[2 * i] holds columns 0-3 and
+ * rows[2 * i + 1] columns 4-7 of output row i.
+ */
+static FORCEINLINE void idct2D(__m128i *rows, const int32 *block) {
+	__m128i s[8], d[8];
+
+	// Blocks with only a DC coefficient are common and transform to a flat block
+	__m128i ac = _mm_loadu_si128((const __m128i *)block);
+	ac = _mm_slli_si128(_mm_srli_si128(ac, 4), 4);
+	for (int i = 1; i < 16; i++)
+		ac = _mm_or_si128(ac, _mm_loadu_si128((const __m128i *)(block + 4 * i)));
+	if (_mm_movemask_epi8(_mm_cmpeq_epi32(ac, _mm_setzero_si128())) == 0xFFFF) {
+		const __m128i dc = _mm_set1_epi32((block[0] + 0x7F) >> 8);
+		for (int i = 0; i < 16; i++)
+			rows[i] = dc;
+		return;
+	}
+
+	// Columns: lane j of vector i is element (i, j), so each lane is a column
+	for (int half = 0; half < 2; half++) {
+		for (int i = 0; i < 8; i++)
+			s[i] = _mm_loadu_si128((const __m128i *)(block + 8 * i + 4 * half));
+		transform<false>(d, s);
+		for (int i = 0; i < 8; i++)
+			rows[2 * i + half] = d[i];
+	}
+
+	// Rows: transpose so that each lane is a row, transform, transpose back
+	for (int half = 0; half < 2; half++) {
+		__m128i *r = rows + 8 * half;
+		s[0] = r[0]; s[1] = r[2]; s[2] = r[4]; s[3] = r[6];
+		s[4] = r[1]; s[5] = r[3]; s[6] = r[5]; s[7] = r[7];
+		transpose4x4(s[0], s[1], s[2], s[3]);
+		transpose4x4(s[4], s[5], s[6], s[7]);
+
+		transform<true>(d, s);
+
+		transpose4x4(d[0], d[1], d[2], d[3]);
+		transpose4x4(d[4], d[5], d[6], d[7]);
+		r[0] = d[0]; r[2] = d[1]; r[4] = d[2]; r[6] = d[3];
+		r[1] = d[4]; r[3] = d[5]; r[5] = d[6]; r[7] = d[7];
+	}
+}
+
+// Keep the low 16 bits of each value, sign extended, so packs_epi32 cannot saturate
+static FORCEINLINE __m128i packLow16(__m128i lo, __m128i hi) {
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	return _mm_packs_epi32(lo, hi);
+}
+
+static FORCEINLINE void storeLow8(byte *dest, __m128i v) {
+	v = _mm_and_si128(v, _mm_set1_epi16(0xFF));
+	_mm_storel_epi64((__m128i *)dest, _mm_packus_epi16(v, v));
+}
+
+static FORCEINLINE __m128i loadRow(const byte *src) {
+	return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)src), _mm_setzero_si128());
+}
+
+static void idctSSE2(int32 *block) {
+	__m128i rows[16];
+	idct2D(rows, block);
+
+	for (int i = 0; i < 16; i++)
+		_mm_storeu_si128((__m128i *)(block + 4 * i), rows[i]);
+}
+
+static void idctPutSSE2(byte *dest, uint32 pitch, int32 *block) {
+	__m128i rows[16];
+	idct2D(rows, block);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		storeLow8(dest, packLow16(rows[2 * i], rows[2 * i + 1]));
+}
+
+static void idctAddSSE2(byte *dest, uint32 pitch, int32 *block) {
+	__m128i rows[16];
+	idct2D(rows, block);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		storeLow8(dest, _mm_add_epi16(loadRow(dest), packLow16(rows[2 * i], rows[2 * i + 1])));
+}
+
+static void addResidueSSE2(byte *dest, uint32 pitch, const int16 *block) {
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8)
+		storeLow8(dest, _mm_add_epi16(loadRow(dest), _mm_loadu_si128((const __m128i *)block)));
+}
+
+void initBinkDSPSSE2(BinkDSP &dsp) {
+	dsp.idct       = idctSSE2;
+	dsp.idctPut    = idctPutSSE2;
+	dsp.idctAdd    = idctAddSSE2;
+	dsp.addResidue = addResidueSSE2;
+}
+
+} // End of namespace Video
+
+#ifdef __GNUC__
+#pragma GCC pop_options
+#endif
+
+#endif // USE_BINK
@@ -0,0 +1,62 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef USE_BINK
+
+#ifndef VIDEO_BINK_DSP_H
+#define VIDEO_BINK_DSP_H
+
+namespace Video {
+
+/**
+ * The pixel kernels of the Bink video decoder, operating on 8x8 blocks.
+ *
+ * All results are truncated to 8 bits, exactly like the reference decoder
+ * does, so the generic and SIMD implementations are bit-exact.
+ */
+struct BinkDSP {
+	/** Inverse transform a block of DCT coefficients in place. */
+	void (*idct)(int32 *block);
+	/** Inverse transform a block and store it into dest. The block is clobbered. */
+	void (*idctPut)(byte *dest, uint32 pitch, int32 *block);
+	/** Inverse transform a block and add it to dest. The block is clobbered. */
+	void (*idctAdd)(byte *dest, uint32 pitch, int32 *block);
+	/** Add a block of residue values to dest. */
+	void (*addResidue)(byte *dest, uint32 pitch, const int16 *block);
+};
+
+void initBinkDSPGeneric(BinkDSP &dsp);
+#ifdef SCUMMVM_SSE2
+void initBinkDSPSSE2(BinkDSP &dsp);
+#endif
+
+/**
+ * Fill in the fastest kernels supported by the running CPU.
+ */
+void initBinkDSP(BinkDSP &dsp);
+
+} // End of namespace Video
+
+#endif // VIDEO_BINK_DSP_H
+
+#endif // USE_BINK
@@ -18,7 +18,12 @@ MODULE_OBJS := \
 
 ifdef USE_BINK
 MODULE_OBJS += \
-	bink_decoder.o
+	bink_decoder.o \
+	bink_dsp.o
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	bink_dsp-sse2.o
+endif
 endif
 
 ifdef USE_THEORADEC